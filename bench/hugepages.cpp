@@ -0,0 +1,182 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		hugepages.cpp
+ * @brief		TLB misses of large channels by page size
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ * @details		Streams items through a sharded channel with a
+ * 				lane of millions of slots, backed by normal
+ * 				pages, transparent huge pages or reserved huge
+ * 				pages, and counts data TLB misses with
+ * 				perf_event_open. Reserve huge pages first, e.g.
+ * 				through /proc/sys/vm/nr_hugepages, or they fall
+ * 				back. Usage: bench_hugepages [items] [capacity]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "piper/factory.hpp"
+#include "piper/internal/sharded.hpp"
+#include "piper/mpsc.hpp"
+#include "piper/numa.hpp"
+
+namespace {
+    /// A cache line sized item, so each slot touches its own line
+    struct Item {
+            std::uint64_t sequence;
+            std::uint64_t payload[7];
+    };
+
+    /// Counts data TLB misses of this thread and threads it spawns
+    class Counter {
+            int fd;
+
+        public:
+            Counter() {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                attr.disabled = 1;
+                attr.inherit = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                fd = static_cast<int>(
+                    syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+
+            Counter(const Counter&) = delete;
+
+            ~Counter() {
+                if (fd >= 0)
+                    close(fd);
+            }
+
+            void start() {
+                if (fd >= 0) {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+
+            /// Stops counting, returning the count or -1 if unavailable
+            long long stop() {
+                long long count = -1;
+                if (fd >= 0) {
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                    if (read(fd, &count, sizeof(count)) != sizeof(count))
+                        count = -1;
+                }
+                return count;
+            }
+    };
+
+    const char* describe(piper::Placement::Pages pages) {
+        switch (pages) {
+        case piper::Placement::Pages::transparent:
+            return "transparent";
+        case piper::Placement::Pages::huge:
+            return "huge";
+        default:
+            return "normal";
+        }
+    }
+
+    /// Streams items through a channel, reporting rate and TLB misses
+    void run(piper::Placement::Pages pages, long items,
+             std::size_t capacity) {
+        // Ask for the lane's actual backing, since requests fall back
+        piper::internal::PlacedArray<char> probe(
+            piper::Placement::huge_page_size(),
+            piper::Placement{}.with(pages));
+        auto backing = probe.pages();
+
+        auto [tx, rx] = piper::make_channel<Item, piper::mpsc::Topology,
+                                            piper::flavor::Sharded>(
+            capacity, piper::Placement{}.with(pages));
+        piper::mpsc::Sender<Item> sender(rx);
+
+        Counter counter;
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+
+        std::thread producer(
+            [items](auto tx) {
+                for (long i = 0; i < items; i++) {
+                    tx << Item{static_cast<std::uint64_t>(i), {}};
+                }
+            },
+            std::move(sender));
+
+        std::uint64_t sum = 0;
+        for (long i = 0; i < items; i++) {
+            sum += rx.recv().sequence;
+        }
+        producer.join();
+
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        auto misses = counter.stop();
+
+        if (sum != static_cast<std::uint64_t>(items) * (items - 1) / 2)
+            std::fprintf(stderr, "lost items\n");
+        std::printf("%-12s %-12s %12.2f", describe(pages), describe(backing),
+                    items / elapsed.count() / 1e6);
+        if (misses >= 0)
+            std::printf(" %14lld %10.3f\n", misses,
+                        static_cast<double>(misses) / items);
+        else
+            std::printf(" %14s %10s\n", "n/a", "n/a");
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    long items = argc > 1 ? std::atol(argv[1]) : 20000000;
+    std::size_t capacity = argc > 2 ? std::atol(argv[2]) : 1 << 22;
+
+    std::printf("%-12s %-12s %12s %14s %10s\n", "requested", "backing",
+                "Mitems/s", "dTLB misses", "per item");
+    for (auto pages :
+         {piper::Placement::Pages::normal, piper::Placement::Pages::transparent,
+          piper::Placement::Pages::huge}) {
+        run(pages, items, capacity);
+    }
+}
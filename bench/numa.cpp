@@ -0,0 +1,154 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		numa.cpp
+ * @brief		Cross-node versus local channel throughput
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ * @details		Pins a producer and a consumer to NUMA nodes and
+ * 				places the channel's storage on each node in
+ * 				turn. Usage: bench_numa [items] [capacity]
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+#include "piper/factory.hpp"
+#include "piper/internal/sharded.hpp"
+#include "piper/mpsc.hpp"
+#include "piper/numa.hpp"
+
+namespace {
+    /// Lists the online nodes
+    std::vector<int> nodes() {
+        std::vector<int> found;
+        std::filesystem::path root = "/sys/devices/system/node";
+        std::error_code error;
+        for (auto& entry : std::filesystem::directory_iterator(root, error)) {
+            auto name = entry.path().filename().string();
+            if (name.rfind("node", 0) == 0 && name.size() > 4 &&
+                std::isdigit(static_cast<unsigned char>(name[4])))
+                found.push_back(std::stoi(name.substr(4)));
+        }
+        if (found.empty())
+            found.push_back(0);
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    /// Reads the CPUs of a node from its cpulist, e.g. "0-3,8-11"
+    cpu_set_t cpus(int node) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        std::ifstream file("/sys/devices/system/node/node" +
+                           std::to_string(node) + "/cpulist");
+        std::string range;
+        while (std::getline(file, range, ',')) {
+            auto dash = range.find('-');
+            int first = std::atoi(range.c_str());
+            int last = dash == std::string::npos
+                           ? first
+                           : std::atoi(range.c_str() + dash + 1);
+            for (int cpu = first; cpu <= last; cpu++) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (CPU_COUNT(&set) == 0)
+            sched_getaffinity(0, sizeof(set), &set);
+        return set;
+    }
+
+    /// Pins the calling thread to a node
+    void pin(int node) {
+        auto set = cpus(node);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+
+    /// Measures items per second through a sharded channel
+    double run(int producer, int consumer, piper::Placement placement,
+               long items, std::size_t capacity) {
+        pin(consumer);
+        auto [tx, rx] =
+            piper::make_channel<long, piper::mpsc::Topology,
+                                piper::flavor::Sharded>(capacity, placement);
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread thread(
+            [producer, items](auto tx) {
+                pin(producer);
+                for (long i = 0; i < items; i++) {
+                    tx << i;
+                }
+            },
+            piper::mpsc::Sender<long>(rx));
+
+        long sum = 0;
+        for (long i = 0; i < items; i++) {
+            sum += rx.recv();
+        }
+        thread.join();
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        if (sum != items * (items - 1) / 2)
+            std::fprintf(stderr, "lost items\n");
+        return items / elapsed.count();
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    long items = argc > 1 ? std::atol(argv[1]) : 10000000;
+    std::size_t capacity = argc > 2 ? std::atol(argv[2]) : 4096;
+    auto online = nodes();
+
+    std::printf("%-9s %-9s %-11s %12s\n", "producer", "consumer", "memory",
+                "Mitems/s");
+    for (int p : online) {
+        for (int c : online) {
+            auto report = [&](const char* name, piper::Placement placement) {
+                auto rate = run(p, c, placement, items, capacity);
+                std::printf("%-9d %-9d %-11s %12.2f\n", p, c, name, rate / 1e6);
+            };
+            report("default", {});
+            report("interleave", piper::Placement::interleaved());
+            for (int m : online) {
+                auto name = "node " + std::to_string(m);
+                report(name.c_str(), piper::Placement::on(m));
+            }
+        }
+    }
+}
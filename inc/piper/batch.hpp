@@ -0,0 +1,333 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		batch.hpp
+ * @brief 		Micro-batching receiver adapter
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "piper/internal/buffer.hpp"
+#include "piper/piper.hpp"
+
+namespace piper {
+    /**
+     * @class 	Batcher
+     * @brief 	A Receiver of batches, gathered from a Receiver of items
+     * @details A batch is handed out once it holds the target number
+     * 			of items, or once its first item has waited max_delay,
+     * 			whichever comes first. An adaptive batcher sets its
+     * 			target from the arrival rate, to the number of items
+     * 			expected within max_delay, capped at max_items: slow
+     * 			streams are flushed item by item without waiting out
+     * 			the delay, and fast ones fill whole batches. When a
+     * 			batch fills while more items are already waiting, the
+     * 			source is backlogged and the target doubles, since the
+     * 			rate seen between receives is then only the sink's
+     * 			throughput. Once the
+     * 			source expires, the items already gathered are handed
+     * 			out before receiving throws.
+     * @tparam 	Rx The type of the source, which must accept a
+     * 			readiness listener, e.g. an MPSC or SPMC Receiver
+     * @note 	The batcher replaces any listener on its source, and
+     * 			forwards its notifications to its own listener.
+     */
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    class Batcher final
+        : public Receiver<std::vector<
+              std::remove_cvref_t<decltype(std::declval<Rx&>().recv())>>> {
+        public:
+            /// The type of item in a batch
+            using Item =
+                std::remove_cvref_t<decltype(std::declval<Rx&>().recv())>;
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            /// Counts readiness notifications from the source, and
+            /// forwards them to a listener
+            struct Signal {
+                    std::mutex mutex;
+                    std::condition_variable changed;
+                    std::uint64_t count = 0;
+                    std::shared_ptr<internal::Listener> listener;
+
+                    void notify() {
+                        std::shared_ptr<internal::Listener> outer;
+                        {
+                            auto lock = std::unique_lock(mutex);
+                            count++;
+                            outer = listener;
+                        }
+                        changed.notify_all();
+                        if (outer)
+                            outer->filled();
+                    }
+            };
+
+            /// Notifies on a filled or destroyed source buffer
+            struct Wake final : internal::Listener {
+                    std::shared_ptr<Signal> signal;
+                    explicit Wake(std::shared_ptr<Signal> signal)
+                        : signal(std::move(signal)) {}
+                    ~Wake() { signal->notify(); }
+                    void filled() override { signal->notify(); }
+                    void drained() override {}
+            };
+
+            Rx rx;
+            std::size_t max_items;
+            Clock::duration max_delay;
+            bool adaptive;
+
+            std::shared_ptr<Signal> signal = std::make_shared<Signal>();
+            std::vector<Item> pending;
+            std::size_t target;
+
+            /// When the first pending item arrived
+            Clock::time_point since;
+
+            /// When the last batch was handed out, and the smoothed
+            /// arrival rate in items per second since then
+            Clock::time_point flushed = Clock::now();
+            double rate = 0;
+
+            /// An item taken past a full batch, which shows a backlog,
+            /// and when it was taken
+            std::optional<Item> carry;
+            Clock::time_point carried;
+            bool backlog = false;
+
+            /**
+             * @brief 	Gathers available items, up to the target
+             * @return 	Whether a batch is ready to be handed out
+             * @throws 	std::runtime_error Thrown if the source has
+             * 			expired and nothing is pending
+             */
+            bool gather();
+
+            /// Hands out the pending items, updating the target
+            std::vector<Item> flush();
+
+        public:
+            /**
+             * @brief 	Constructs a Batcher
+             * @param 	rx The source, owned by the batcher
+             * @param 	max_items The largest batch, at least 1
+             * @param 	max_delay The longest an item waits in a batch
+             * @param 	adaptive Whether to adapt the target batch size
+             * 			to the arrival rate
+             */
+            Batcher(Rx rx, std::size_t max_items,
+                    std::chrono::nanoseconds max_delay, bool adaptive = false);
+
+            Batcher(Batcher<Rx>&&) = default;
+            Batcher(const Batcher<Rx>&) = delete;
+
+            /**
+             * @brief 	Receives a batch
+             * @return 	At least one item, and at most max_items
+             * @throws 	std::runtime_error Thrown once the source has
+             * 			expired and every item has been handed out
+             * @note 	Blocks until a batch is ready
+             */
+            std::vector<Item> recv() override;
+
+            /**
+             * @brief 	Receives a batch, if one is ready
+             * @return 	The batch, or std::nullopt if it is not yet full
+             * 			nor overdue
+             * @throws 	std::runtime_error Thrown once the source has
+             * 			expired and every item has been handed out
+             */
+            std::optional<std::vector<Item>> try_recv() override;
+
+            /**
+             * @brief 	Attaches a readiness listener to the batcher
+             * @param 	listener Notified whenever the source may have
+             * 			become ready, or has expired
+             * @note 	A pending batch also becomes ready at due().
+             */
+            void listen(std::shared_ptr<internal::Listener> listener);
+
+            /**
+             * @brief 	Gets when the pending batch becomes overdue
+             * @return 	The time, or std::nullopt if nothing is pending
+             */
+            std::optional<Clock::time_point> due() const;
+
+            /// Gets the current target batch size
+            std::size_t size() const { return target; }
+    };
+
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    Batcher<Rx>::Batcher(Rx rx, std::size_t max_items,
+                         std::chrono::nanoseconds max_delay, bool adaptive)
+        : rx(std::move(rx)), max_items(std::max<std::size_t>(max_items, 1)),
+          max_delay(std::chrono::duration_cast<Clock::duration>(max_delay)),
+          adaptive(adaptive), target(this->max_items) {
+        try {
+            this->rx.listen(std::make_shared<Wake>(signal));
+        } catch (const std::runtime_error&) {
+            // An expired source throws again when received from
+        }
+    }
+
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    bool Batcher<Rx>::gather() {
+        if (carry) {
+            if (pending.empty())
+                since = carried;
+            pending.push_back(std::move(*carry));
+            carry.reset();
+        }
+        try {
+            while (pending.size() < target) {
+                auto item = rx.try_recv();
+                if (!item)
+                    break;
+                if (pending.empty())
+                    since = Clock::now();
+                pending.push_back(std::move(*item));
+            }
+
+            // Look for one more item, to tell a backlog from a source
+            // that just kept up
+            if (adaptive && pending.size() >= target) {
+                carry = rx.try_recv();
+                carried = Clock::now();
+                backlog = carry.has_value();
+            }
+        } catch (const std::runtime_error&) {
+            if (pending.empty())
+                throw;
+            return true;
+        }
+        return pending.size() >= target ||
+               (!pending.empty() && Clock::now() - since >= max_delay);
+    }
+
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    std::vector<typename Batcher<Rx>::Item> Batcher<Rx>::flush() {
+        auto now = Clock::now();
+        if (adaptive) {
+            std::chrono::duration<double> window = max_delay;
+            if (std::exchange(backlog, false)) {
+                // Every item that arrived was not gathered, so the rate
+                // is unknown but at least enough to fill larger batches
+                target = std::min(target * 2, max_items);
+                rate = std::max(rate, target / window.count());
+            } else {
+                // Every item that arrived since the last batch is here
+                std::chrono::duration<double> elapsed = now - flushed;
+                auto sample =
+                    pending.size() / std::max(elapsed.count(), 1e-9);
+                rate = rate ? rate * 0.75 + sample * 0.25 : sample;
+
+                auto expected =
+                    static_cast<std::size_t>(rate * window.count());
+                target = std::clamp<std::size_t>(expected, 1, max_items);
+            }
+        }
+        flushed = now;
+
+        std::vector<Item> batch;
+        batch.reserve(target);
+        std::swap(batch, pending);
+        return batch;
+    }
+
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    std::vector<typename Batcher<Rx>::Item> Batcher<Rx>::recv() {
+        for (;;) {
+            std::uint64_t seen;
+            {
+                auto lock = std::unique_lock(signal->mutex);
+                seen = signal->count;
+            }
+            if (gather())
+                return flush();
+
+            auto lock = std::unique_lock(signal->mutex);
+            auto notified = [&] { return signal->count != seen; };
+            if (auto until = due())
+                signal->changed.wait_until(lock, *until, notified);
+            else
+                signal->changed.wait(lock, notified);
+        }
+    }
+
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    std::optional<std::vector<typename Batcher<Rx>::Item>>
+    Batcher<Rx>::try_recv() {
+        if (gather())
+            return flush();
+        return std::nullopt;
+    }
+
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    void Batcher<Rx>::listen(std::shared_ptr<internal::Listener> listener) {
+        {
+            auto lock = std::unique_lock(signal->mutex);
+            signal->listener = listener;
+        }
+
+        // The source may already hold items, which will not notify again
+        if (listener)
+            listener->filled();
+    }
+
+    template <typename Rx>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    auto Batcher<Rx>::due() const -> std::optional<Clock::time_point> {
+        if (pending.empty())
+            return std::nullopt;
+        return since + max_delay;
+    }
+} // namespace piper
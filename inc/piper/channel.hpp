@@ -31,6 +31,8 @@
  *  @date	 	2022-04-19
  */
 
+#pragma once
+
 #include <memory>
 #include <utility>
 namespace piper {
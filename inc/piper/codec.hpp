@@ -0,0 +1,127 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		codec.hpp
+ * @brief 		Item serialization for channels that leave memory
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace piper {
+    /**
+     * @struct 	Codec
+     * @brief 	Serializes items to and from bytes
+     * @details The primary template copies the object representation
+     * 			of trivially copyable items. Specialize Codec, or pass
+     * 			a type with the same static members, to serialize
+     * 			other items.
+     * @tparam 	T The type of item being serialized
+     */
+    template <typename T> struct Codec {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "items without a Codec must be trivially copyable");
+
+            /**
+             * @brief 	Appends the serialized item to a byte buffer
+             * @param 	item The item being serialized
+             * @param 	out The buffer to append to
+             */
+            static void encode(const T& item, std::vector<std::byte>& out) {
+                auto bytes = reinterpret_cast<const std::byte*>(&item);
+                out.insert(out.end(), bytes, bytes + sizeof(T));
+            }
+
+            /**
+             * @brief 	Deserializes an item
+             * @param 	in The bytes of exactly one serialized item
+             * @return 	The deserialized item
+             * @throws 	std::runtime_error Thrown if in has the wrong size
+             */
+            static T decode(std::span<const std::byte> in) {
+                if (in.size() != sizeof(T))
+                    throw std::runtime_error("malformed item");
+                T item;
+                std::memcpy(&item, in.data(), sizeof(T));
+                return item;
+            }
+    };
+
+    /**
+     * @struct 	Codec<std::vector<U, A>>
+     * @brief 	Serializes vectors of trivially copyable elements
+     */
+    template <typename U, typename A> struct Codec<std::vector<U, A>> {
+            static_assert(std::is_trivially_copyable_v<U>,
+                          "vector elements must be trivially copyable");
+
+            static void encode(const std::vector<U, A>& item,
+                               std::vector<std::byte>& out) {
+                auto bytes = reinterpret_cast<const std::byte*>(item.data());
+                out.insert(out.end(), bytes, bytes + item.size() * sizeof(U));
+            }
+
+            static std::vector<U, A> decode(std::span<const std::byte> in) {
+                if (in.size() % sizeof(U) != 0)
+                    throw std::runtime_error("malformed item");
+                std::vector<U, A> item(in.size() / sizeof(U));
+                std::memcpy(item.data(), in.data(), in.size());
+                return item;
+            }
+    };
+
+    /**
+     * @struct 	Codec<std::basic_string<C, Tr, A>>
+     * @brief 	Serializes strings
+     */
+    template <typename C, typename Tr, typename A>
+    struct Codec<std::basic_string<C, Tr, A>> {
+            static void encode(const std::basic_string<C, Tr, A>& item,
+                               std::vector<std::byte>& out) {
+                auto bytes = reinterpret_cast<const std::byte*>(item.data());
+                out.insert(out.end(), bytes, bytes + item.size() * sizeof(C));
+            }
+
+            static std::basic_string<C, Tr, A>
+            decode(std::span<const std::byte> in) {
+                if (in.size() % sizeof(C) != 0)
+                    throw std::runtime_error("malformed item");
+                std::basic_string<C, Tr, A> item(in.size() / sizeof(C), C());
+                std::memcpy(item.data(), in.data(), in.size());
+                return item;
+            }
+    };
+} // namespace piper
@@ -0,0 +1,125 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		factory.hpp
+ * @brief 		Channel factory and buffer flavor tags
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "piper/internal/buffer.hpp"
+
+/**
+ * @namespace 	piper::flavor
+ * @brief 		Tags selecting the buffer flavor in piper::make_channel
+ */
+namespace piper::flavor {
+    /**
+     * @struct 	Async
+     * @brief 	Selects an asynchronous, unbounded buffer
+     */
+    struct Async {
+            template <typename T> using Buffer = internal::AsyncBuffer<T>;
+    };
+
+    /**
+     * @struct 	Sync
+     * @brief 	Selects a synchronous, bounded buffer
+     */
+    struct Sync {
+            template <typename T> using Buffer = internal::SyncBuffer<T>;
+    };
+
+    /**
+     * @struct 	Rendezvous
+     * @brief 	Selects a synchronous, rendezvous buffer
+     */
+    struct Rendezvous {
+            template <typename T> using Buffer = internal::RendezvousBuffer<T>;
+    };
+
+    /**
+     * @struct 	Static
+     * @brief 	Selects a bounded buffer with inline storage
+     * @tparam 	N The capacity of the buffer, a power of two
+     */
+    template <std::size_t N> struct Static {
+            template <typename T> using Buffer = internal::StaticBuffer<T, N>;
+    };
+
+    /**
+     * @struct 	Elastic
+     * @brief 	Selects a bounded buffer with soft and hard capacities
+     */
+    struct Elastic {
+            template <typename T> using Buffer = internal::ElasticBuffer<T>;
+    };
+
+    /**
+     * @struct 	Priority
+     * @brief 	Selects a priority-ordered buffer
+     * @tparam 	Compare The ordering of items, greatest popped first
+     * @note 	The buffer is unbounded unless a capacity is passed
+     */
+    template <typename Compare = std::less<>> struct Priority {
+            template <typename T>
+            using Buffer = internal::PriorityBuffer<T, Compare>;
+    };
+} // namespace piper::flavor
+
+namespace piper {
+    /**
+     * @brief 	Constructs a connected Sender and Receiver
+     * @details The buffer and its shared ownership control block are
+     * 			created in a single allocation, and the endpoints are
+     * 			returned by value.
+     * @tparam 	T The type of item being exchanged over the channel
+     * @tparam 	Topology The endpoint topology, e.g. piper::mpsc::Topology
+     * @tparam 	Flavor The buffer flavor, e.g. piper::flavor::Sync
+     * @param 	args The buffer constructor arguments, e.g. its capacity
+     * @return 	The connected Sender and Receiver
+     * @note 	A flavor that names a Topology, such as Sharded or
+     * 			Stealing, fails to compile with any other.
+     */
+    template <typename T, typename Topology, typename Flavor, typename... Args>
+    auto make_channel(Args&&... args) {
+        if constexpr (requires { typename Flavor::Topology; })
+            static_assert(std::is_same_v<Topology, typename Flavor::Topology>,
+                          "the flavor does not support this topology");
+        using Buffer = typename Flavor::template Buffer<T>;
+        return Topology::template connect<T>(
+            std::make_shared<Buffer>(std::forward<Args>(args)...));
+    }
+} // namespace piper
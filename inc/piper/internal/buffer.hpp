@@ -32,17 +32,70 @@
  * @date		2022-04-19
  */
 
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <memory>
+#include <functional>
+#include <limits>
 #include <mutex>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+namespace piper {
+    /**
+     * @enum 	Overflow
+     * @brief 	What a bounded buffer does with an item pushed while full
+     */
+    enum class Overflow {
+        /// Block the sender until there is room
+        block,
+        /// Discard the item being pushed
+        drop_newest,
+        /// Discard the oldest item in the buffer to make room; a
+        /// priority buffer discards the item it would pop last
+        drop_oldest,
+        /// Throw std::runtime_error from push
+        fail,
+    };
+} // namespace piper
 
 /**
  * @namespace 	piper::internal
  * @brief 		Channel inner buffer interface and implementations
  */
 namespace piper::internal {
+    /**
+     * @interface 	Listener
+     * @brief 		Observes a buffer becoming non-empty or empty
+     * @note 		Callbacks run with the buffer lock held, and must
+     * 				not call back into the buffer.
+     */
+    class Listener {
+        public:
+            /**
+             * @brief 	Destructs a Listener
+             */
+            virtual ~Listener() {}
+
+            /// Called when an item is pushed into an empty buffer
+            virtual void filled() = 0;
+
+            /// Called when the last item is popped from the buffer
+            virtual void drained() = 0;
+    };
+
     /**
      * @class	Buffer
      * @brief 	Shared channel buffer base class
@@ -50,15 +103,47 @@ namespace piper::internal {
      */
     template <typename T> class Buffer {
         protected:
-            std::mutex mutex;
+            mutable std::mutex mutex;
+
+            /// The number of items discarded on overflow
+            std::atomic<std::size_t> discarded = 0;
+
+            /// The listener for readiness transitions, if any
+            std::shared_ptr<Listener> listener;
+
+            /**
+             * @brief 	Checks whether the buffer holds no items
+             * @note 	Called with the buffer lock held
+             */
+            virtual bool empty() const = 0;
+
+            /// Notifies the listener of an empty to non-empty transition
+            void filled() {
+                if (listener)
+                    listener->filled();
+            }
+
+            /// Notifies the listener of a non-empty to empty transition
+            void drained() {
+                if (listener)
+                    listener->drained();
+            }
 
         public:
+            /**
+             * @brief 	Destructs a Buffer
+             */
+            virtual ~Buffer() {}
+
             /**
              * @brief 	Copies and pushes an item into the buffer
              * @param 	item The item being pushed into the buffer
-             * @note 	Implementors of this virtual method may block.
+             * @note 	The item is copied outside of the buffer lock,
+             * 			then forwarded to push(T&&). Only available if
+             * 			T is copy constructible.
              */
-            virtual void push(const T& item) = 0;
+            void push(const T& item)
+                requires std::copy_constructible<T>;
 
             /**
              * @brief 	Moves and pushes an item into the buffer
@@ -74,6 +159,51 @@ namespace piper::internal {
              * 		 	on an empty buffer
              */
             virtual T pop() = 0;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	Implementors of this virtual method will not block
+             */
+            virtual std::optional<T> try_pop() = 0;
+
+            /**
+             * @brief 	Gets the buffer a new endpoint should use
+             * @param 	self The shared pointer owning this buffer
+             * @return 	self, unless the buffer gives each endpoint its
+             * 			own lane
+             * @note 	Called when a Sender (MPSC) or a Receiver (SPMC)
+             * 			is copied from the endpoint owning the buffer
+             */
+            virtual std::shared_ptr<Buffer<T>>
+            attach(std::shared_ptr<Buffer<T>> self) {
+                return self;
+            }
+
+            /**
+             * @brief 	Releases a buffer returned by attach()
+             * @note 	Called when the attached endpoint is destructed
+             */
+            virtual void detach() {}
+
+            /**
+             * @brief 	Attaches a readiness listener to the buffer
+             * @param 	listener The listener, or nullptr to detach
+             * @throws 	std::logic_error Should be thrown by buffers that
+             * 			cannot notify listeners
+             * @note 	If the buffer already holds items, the listener
+             * 			is notified immediately.
+             */
+            virtual void listen(std::shared_ptr<Listener> listener);
+
+            /**
+             * @brief 	Gets the number of items discarded on overflow
+             * @return 	The number of items dropped by the buffer
+             */
+            std::size_t dropped() const {
+                return discarded.load(std::memory_order_relaxed);
+            }
     };
 
     /**
@@ -86,6 +216,12 @@ namespace piper::internal {
             std::condition_variable available;
             std::deque<T> queue;
 
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes the next item, with the buffer lock held
+            T take();
+
         public:
             /**
              * @brief Constructs an asynchronous buffer
@@ -95,12 +231,7 @@ namespace piper::internal {
             AsyncBuffer(const AsyncBuffer<T>&) = delete;
             AsyncBuffer(AsyncBuffer<T>&&) = delete;
 
-            /**
-             * @brief 	Copies and pushes an item into the buffer
-             * @param 	item The item being pushed into the buffer
-             * @note 	This implementation should not block
-             */
-            void push(const T& item) override;
+            using Buffer<T>::push;
 
             /**
              * @brief 	Moves and pushes an item into the buffer
@@ -115,6 +246,14 @@ namespace piper::internal {
              * @note 	Blocks on an empty buffer
              */
             T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
     };
 
     /**
@@ -126,38 +265,113 @@ namespace piper::internal {
     template <typename T> class SyncBuffer : public Buffer<T> {
         protected:
             std::size_t n;
+            Overflow policy;
             std::deque<T> queue;
             std::condition_variable available[2];
 
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes the next item, with the buffer lock held
+            T take();
+
         public:
             /**
              * @brief 	Constructs a synchronous buffer
              * @param 	n The size of the buffer
+             * @param 	policy The behavior of push on a full buffer
              * @note 	The size of the buffer should be at least 1.
              * 			If an unbuffered channel is desired, use
              * 			RendezvousBuffer.
              * @warning Passing n = 0 to this constructor may result
              * 			in undefined behavior
              */
-            SyncBuffer(std::size_t n) : Buffer<T>(), n(n){};
+            SyncBuffer(std::size_t n, Overflow policy = Overflow::block)
+                : Buffer<T>(), n(n), policy(policy){};
 
             SyncBuffer() = delete;
             SyncBuffer(const SyncBuffer<T>&) = delete;
             SyncBuffer(SyncBuffer<T>&&) = delete;
 
+            using Buffer<T>::push;
+
             /**
-             * @brief 	Copies and pushes an item into the buffer
+             * @brief 	Moves and pushes an item into the buffer
              * @param 	item The item being pushed into the buffer
-             * @note 	This implementation should not block
+             * @throws 	std::runtime_error Thrown if the buffer is full
+             * 			and the policy is Overflow::fail
+             * @note 	Blocks on a full buffer if the policy is
+             * 			Overflow::block
+             */
+            virtual void push(T&& item) override;
+
+            /**
+             * @brief Pops an item from the buffer
+             * @return The item being popped from the buffer
+             * @note Blocks on an empty buffer
              */
-            virtual void push(const T& item) override;
+            T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
+    };
+
+    /**
+     * @class 	StaticBuffer
+     * @brief 	A synchronous, bounded buffer with inline storage
+     * @details Items are stored in a fixed ring inside the buffer itself,
+     * 			indexed by masking free-running counters, so no memory
+     * 			is allocated after construction.
+     * @tparam 	T The type of item stored in the buffer
+     * @tparam 	N The capacity of the buffer, a power of two
+     * @extends Buffer
+     */
+    template <typename T, std::size_t N>
+    class StaticBuffer final : public Buffer<T> {
+            static_assert(N > 0 && (N & (N - 1)) == 0,
+                          "StaticBuffer capacity must be a power of two");
+
+            static constexpr std::size_t mask = N - 1;
+
+            std::size_t head = 0;
+            std::size_t tail = 0;
+            Overflow policy;
+            std::condition_variable available[2];
+            std::array<T, N> ring;
+
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes the next item, with the buffer lock held
+            T take();
+
+        public:
+            /**
+             * @brief 	Constructs a static buffer
+             * @param 	policy The behavior of push on a full buffer
+             */
+            StaticBuffer(Overflow policy = Overflow::block)
+                : Buffer<T>(), policy(policy){};
+
+            StaticBuffer(const StaticBuffer<T, N>&) = delete;
+            StaticBuffer(StaticBuffer<T, N>&&) = delete;
+
+            using Buffer<T>::push;
 
             /**
              * @brief 	Moves and pushes an item into the buffer
              * @param 	item The item being pushed into the buffer
-             * @note 	This implementation should not block
+             * @throws 	std::runtime_error Thrown if the buffer is full
+             * 			and the policy is Overflow::fail
+             * @note 	Blocks on a full buffer if the policy is
+             * 			Overflow::block
              */
-            virtual void push(T&& item) override;
+            void push(T&& item) override;
 
             /**
              * @brief Pops an item from the buffer
@@ -165,6 +379,261 @@ namespace piper::internal {
              * @note Blocks on an empty buffer
              */
             T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
+    };
+
+    /**
+     * @class 	PriorityBuffer
+     * @brief 	A priority-ordered buffer, bounded or unbounded
+     * @details Items are kept in a 4-ary heap, so the highest priority
+     * 			item is popped first. Items of equal priority are popped
+     * 			in the order they were pushed. When a bounded buffer is
+     * 			full, Overflow::drop_oldest keeps the items that would
+     * 			be popped first, discarding the lowest priority one,
+     * 			the newest among equals, which may be the item being
+     * 			pushed.
+     * @tparam 	T The type of item stored in the buffer
+     * @tparam 	Compare The ordering of items; as with
+     * 			std::priority_queue, the greatest item is popped first
+     * @extends Buffer
+     */
+    template <typename T, typename Compare = std::less<T>>
+    class PriorityBuffer final : public Buffer<T> {
+            /// Arity of the heap
+            static constexpr std::size_t D = 4;
+
+            /// A heap entry, sequenced for FIFO order among equals
+            struct Entry {
+                    T item;
+                    std::uint64_t seq;
+            };
+
+            std::size_t n;
+            Overflow policy = Overflow::block;
+            std::uint64_t seq = 0;
+            std::vector<Entry> heap;
+            std::condition_variable available[2];
+            Compare compare;
+
+            /// Whether entry a is popped before entry b
+            bool before(const Entry& a, const Entry& b) const;
+
+            /// Restores the heap upwards from index i
+            void sift_up(std::size_t i);
+
+            /// Restores the heap downwards from index i
+            void sift_down(std::size_t i);
+
+            /// Finds the entry popped last, which is always a leaf
+            std::size_t last() const;
+
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes the next item, with the buffer lock held
+            T take();
+
+        public:
+            /**
+             * @brief 	Constructs an unbounded priority buffer
+             * @param 	compare The ordering of items
+             */
+            PriorityBuffer(Compare compare = Compare())
+                : Buffer<T>(), n(std::numeric_limits<std::size_t>::max()),
+                  compare(std::move(compare)) {}
+
+            /**
+             * @brief 	Constructs a bounded priority buffer
+             * @param 	n The size of the buffer
+             * @param 	compare The ordering of items
+             * @warning Passing n = 0 to this constructor will block
+             * 			every call to push
+             */
+            PriorityBuffer(std::size_t n, Compare compare = Compare())
+                : Buffer<T>(), n(n), compare(std::move(compare)) {}
+
+            /**
+             * @brief 	Constructs a bounded priority buffer
+             * @param 	n The size of the buffer
+             * @param 	policy The behavior of push on a full buffer
+             * @param 	compare The ordering of items
+             */
+            PriorityBuffer(std::size_t n, Overflow policy,
+                           Compare compare = Compare())
+                : Buffer<T>(), n(n), policy(policy),
+                  compare(std::move(compare)) {}
+
+            PriorityBuffer(const PriorityBuffer<T, Compare>&) = delete;
+            PriorityBuffer(PriorityBuffer<T, Compare>&&) = delete;
+
+            using Buffer<T>::push;
+
+            /**
+             * @brief 	Moves and pushes an item into the buffer
+             * @param 	item The item being pushed into the buffer
+             * @throws 	std::runtime_error Thrown if the buffer is full
+             * 			and the policy is Overflow::fail
+             * @note 	Blocks on a full, bounded buffer if the policy is
+             * 			Overflow::block
+             */
+            void push(T&& item) override;
+
+            /**
+             * @brief Pops the highest priority item from the buffer
+             * @return The item being popped from the buffer
+             * @note Blocks on an empty buffer
+             */
+            T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
+    };
+
+    /**
+     * @class 	ElasticBuffer
+     * @brief 	A synchronous buffer that grows under bursts
+     * @details Storage starts at a soft capacity and doubles, up to a
+     * 			hard capacity, whenever a push finds it full. The
+     * 			overflow policy applies only at the hard capacity,
+     * 			where senders block by default. Once the buffer has
+     * 			held no more than the soft capacity for a number of
+     * 			consecutive pushes and pops, or for long enough,
+     * 			storage shrinks back to the soft capacity. Both are
+     * 			checked on each push and pop, including a try_pop()
+     * 			that finds the buffer empty, and a receiver blocked
+     * 			on an empty buffer wakes to shrink it once it has
+     * 			lingered. Storage is allocated and freed without the
+     * 			buffer lock held.
+     * @tparam 	T The type of item stored in the buffer
+     * @extends Buffer
+     */
+    template <typename T> class ElasticBuffer final : public Buffer<T> {
+            std::size_t soft;
+            std::size_t hard;
+            Overflow policy;
+            std::size_t hysteresis;
+            std::chrono::steady_clock::duration linger;
+
+            /// Consecutive pushes and pops that left at most soft items,
+            /// and when the last one that left more happened
+            std::size_t calm = 0;
+            std::chrono::steady_clock::time_point busy;
+
+            std::size_t head = 0;
+            std::size_t count = 0;
+            std::vector<T> ring;
+            std::condition_variable available[2];
+
+            /**
+             * @brief 	Moves the items into storage of the given size
+             * @param 	lock The buffer lock, released while storage is
+             * 			allocated and freed
+             * @param 	size The new size, skipped if the items no
+             * 			longer fit or the size is already right
+             */
+            void resize(std::unique_lock<std::mutex>& lock, std::size_t size);
+
+            /**
+             * @brief 	Checks whether storage should shrink, now that the
+             * 			burst has drained for long enough
+             * @note 	Called with the buffer lock held
+             */
+            bool settle();
+
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes the next item, with the buffer lock held
+            T take();
+
+        public:
+            /**
+             * @brief 	Constructs an elastic buffer
+             * @param 	soft The initial size of the buffer
+             * @param 	hard The maximum size of the buffer
+             * @param 	hysteresis The number of consecutive pushes and
+             * 			pops at or below the soft capacity before
+             * 			storage shrinks
+             * @param 	linger How long the buffer may stay at or below
+             * 			the soft capacity before storage shrinks
+             * @note 	Both sizes should be at least 1, and soft should
+             * 			not exceed hard.
+             */
+            ElasticBuffer(std::size_t soft, std::size_t hard,
+                          std::size_t hysteresis = 64,
+                          std::chrono::steady_clock::duration linger =
+                              std::chrono::seconds(1))
+                : ElasticBuffer(soft, hard, Overflow::block, hysteresis,
+                                linger) {}
+
+            /**
+             * @brief 	Constructs an elastic buffer
+             * @param 	soft The initial size of the buffer
+             * @param 	hard The maximum size of the buffer
+             * @param 	policy The behavior of push at the hard capacity
+             * @param 	hysteresis The number of consecutive pushes and
+             * 			pops at or below the soft capacity before
+             * 			storage shrinks
+             * @param 	linger How long the buffer may stay at or below
+             * 			the soft capacity before storage shrinks
+             */
+            ElasticBuffer(std::size_t soft, std::size_t hard, Overflow policy,
+                          std::size_t hysteresis = 64,
+                          std::chrono::steady_clock::duration linger =
+                              std::chrono::seconds(1))
+                : Buffer<T>(), soft(soft), hard(hard), policy(policy),
+                  hysteresis(hysteresis), linger(linger), ring(soft) {}
+
+            ElasticBuffer() = delete;
+            ElasticBuffer(const ElasticBuffer<T>&) = delete;
+            ElasticBuffer(ElasticBuffer<T>&&) = delete;
+
+            using Buffer<T>::push;
+
+            /**
+             * @brief 	Moves and pushes an item into the buffer
+             * @param 	item The item being pushed into the buffer
+             * @throws 	std::runtime_error Thrown if the buffer is at its
+             * 			hard capacity and the policy is Overflow::fail
+             * @note 	Grows a full buffer, and blocks only once the
+             * 			hard capacity is reached, if the policy is
+             * 			Overflow::block
+             */
+            void push(T&& item) override;
+
+            /**
+             * @brief Pops an item from the buffer
+             * @return The item being popped from the buffer
+             * @note Blocks on an empty buffer
+             */
+            T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
+
+            /**
+             * @brief 	Gets the current size of the storage
+             * @return 	The number of items the buffer can hold
+             * 			before growing
+             */
+            std::size_t capacity() const;
     };
 
     /**
@@ -180,6 +649,12 @@ namespace piper::internal {
             std::optional<T> item;
             std::condition_variable available[3];
 
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes the next item, with the buffer lock held
+            T take();
+
         public:
             /**
              * @brief Constructs a rendezvous buffer
@@ -189,12 +664,7 @@ namespace piper::internal {
             RendezvousBuffer(const RendezvousBuffer<T>&) = delete;
             RendezvousBuffer(RendezvousBuffer<T>&&) = delete;
 
-            /**
-             * @brief 	Copies and pushes an item into the buffer
-             * @param 	item The item being pushed into the buffer
-             * @note 	This implementation should not block
-             */
-            void push(const T& item) override;
+            using Buffer<T>::push;
 
             /**
              * @brief 	Moves and pushes an item into the buffer
@@ -209,18 +679,41 @@ namespace piper::internal {
              * @note Blocks awaiting a call to push()
              */
             T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
     };
 
-    template <typename T> void AsyncBuffer<T>::push(const T& item) {
-        {
-            // Acquire lock
-            auto lock = std::unique_lock(this->mutex);
+    template <typename T>
+    void Buffer<T>::listen(std::shared_ptr<Listener> listener) {
+        auto lock = std::unique_lock(this->mutex);
+        this->listener = std::move(listener);
+        if (!empty())
+            filled();
+    }
 
-            // Push item to queue
-            this->queue.push_back(item);
-        }
+    template <typename T>
+    void Buffer<T>::push(const T& item)
+        requires std::copy_constructible<T>
+    {
+        push(T(item));
+    }
 
-        this->available.notify_one();
+    template <typename T> bool AsyncBuffer<T>::empty() const {
+        return this->queue.empty();
+    }
+
+    template <typename T> T AsyncBuffer<T>::take() {
+        T item = std::move(this->queue.front());
+        this->queue.pop_front();
+        if (this->queue.empty())
+            this->drained();
+        return item;
     }
 
     template <typename T> void AsyncBuffer<T>::push(T&& item) {
@@ -230,6 +723,8 @@ namespace piper::internal {
 
             // Push item to queue
             this->queue.push_back(std::forward<T>(item));
+            if (this->queue.size() == 1)
+                this->filled();
         }
 
         this->available.notify_one();
@@ -245,26 +740,30 @@ namespace piper::internal {
             this->available.wait(lock, [this] { return !this->queue.empty(); });
 
             // Pop item from queue
-            item = this->queue.front();
-            this->queue.pop_front();
+            item = take();
         }
         return item;
     }
 
-    template <typename T> void SyncBuffer<T>::push(const T& item) {
-        {
-            // Acquire lock
-            auto lock = std::unique_lock(this->mutex);
+    template <typename T> std::optional<T> AsyncBuffer<T>::try_pop() {
+        // Acquire lock
+        auto lock = std::unique_lock(this->mutex);
 
-            // Block sender if queue is full
-            this->available[1].wait(lock,
-                                    [this] { return this->queue.size() < n; });
+        if (this->queue.empty())
+            return std::nullopt;
+        return take();
+    }
 
-            // Push item to queue
-            this->queue.push_back(item);
-        }
-        // Notify a waiting receiver
-        this->available[0].notify_one();
+    template <typename T> bool SyncBuffer<T>::empty() const {
+        return this->queue.empty();
+    }
+
+    template <typename T> T SyncBuffer<T>::take() {
+        T item = std::move(this->queue.front());
+        this->queue.pop_front();
+        if (this->queue.empty())
+            this->drained();
+        return item;
     }
 
     template <typename T> void SyncBuffer<T>::push(T&& item) {
@@ -272,12 +771,29 @@ namespace piper::internal {
             // Acquire lock
             auto lock = std::unique_lock(this->mutex);
 
-            // Block sender if queue is full
-            this->available[1].wait(lock,
-                                    [this] { return this->queue.size() < n; });
+            // Apply overflow policy if queue is full
+            if (this->queue.size() >= n) {
+                switch (policy) {
+                case Overflow::block:
+                    this->available[1].wait(
+                        lock, [this] { return this->queue.size() < n; });
+                    break;
+                case Overflow::drop_newest:
+                    this->discarded++;
+                    return;
+                case Overflow::drop_oldest:
+                    this->queue.pop_front();
+                    this->discarded++;
+                    break;
+                case Overflow::fail:
+                    throw std::runtime_error("buffer is full");
+                }
+            }
 
             // Push item to queue
             this->queue.push_back(std::forward<T>(item));
+            if (this->queue.size() == 1)
+                this->filled();
         }
         // Notify a waiting receiver
         this->available[0].notify_one();
@@ -294,8 +810,7 @@ namespace piper::internal {
                                     [this] { return !this->queue.empty(); });
 
             // Pop item from queue
-            item = this->queue.front();
-            this->queue.pop_front();
+            item = take();
         }
         // Notify a waiting sender
         this->available[1].notify_one();
@@ -303,28 +818,421 @@ namespace piper::internal {
         return item;
     }
 
-    template <typename T> void RendezvousBuffer<T>::push(const T& item) {
+    template <typename T> std::optional<T> SyncBuffer<T>::try_pop() {
+        std::optional<T> item;
         {
             // Acquire lock
             auto lock = std::unique_lock(this->mutex);
 
-            // Block sender until buffer is ready
-            this->available[1].wait(lock, [this] { return !this->item; });
+            if (this->queue.empty())
+                return std::nullopt;
+            item = take();
+        }
+        // Notify a waiting sender
+        this->available[1].notify_one();
 
-            // Push item to queue
-            this->item = item;
+        return item;
+    }
+
+    template <typename T, std::size_t N>
+    bool StaticBuffer<T, N>::empty() const {
+        return this->tail == this->head;
+    }
+
+    template <typename T, std::size_t N> T StaticBuffer<T, N>::take() {
+        T item = std::move(this->ring[this->head++ & mask]);
+        if (this->tail == this->head)
+            this->drained();
+        return item;
+    }
+
+    template <typename T, std::size_t N>
+    void StaticBuffer<T, N>::push(T&& item) {
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            // Apply overflow policy if ring is full
+            if (this->tail - this->head >= N) {
+                switch (policy) {
+                case Overflow::block:
+                    this->available[1].wait(
+                        lock, [this] { return this->tail - this->head < N; });
+                    break;
+                case Overflow::drop_newest:
+                    this->discarded++;
+                    return;
+                case Overflow::drop_oldest:
+                    // Overwrite the oldest slot
+                    this->head++;
+                    this->discarded++;
+                    break;
+                case Overflow::fail:
+                    throw std::runtime_error("buffer is full");
+                }
+            }
+
+            // Push item to ring
+            this->ring[this->tail++ & mask] = std::forward<T>(item);
+            if (this->tail - this->head == 1)
+                this->filled();
         }
+        // Notify a waiting receiver
+        this->available[0].notify_one();
+    }
 
-        // Notify a waiting receiver that buffer is filled
+    template <typename T, std::size_t N> T StaticBuffer<T, N>::pop() {
+        T item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            // Block receiver if ring is empty
+            this->available[0].wait(
+                lock, [this] { return this->tail != this->head; });
+
+            // Pop item from ring
+            item = take();
+        }
+        // Notify a waiting sender
+        this->available[1].notify_one();
+
+        return item;
+    }
+
+    template <typename T, std::size_t N>
+    std::optional<T> StaticBuffer<T, N>::try_pop() {
+        std::optional<T> item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            if (this->tail == this->head)
+                return std::nullopt;
+            item = take();
+        }
+        // Notify a waiting sender
+        this->available[1].notify_one();
+
+        return item;
+    }
+
+    template <typename T, typename Compare>
+    bool PriorityBuffer<T, Compare>::before(const Entry& a,
+                                            const Entry& b) const {
+        if (compare(b.item, a.item))
+            return true;
+        if (compare(a.item, b.item))
+            return false;
+        return a.seq < b.seq;
+    }
+
+    template <typename T, typename Compare>
+    void PriorityBuffer<T, Compare>::sift_up(std::size_t i) {
+        auto entry = std::move(this->heap[i]);
+        while (i > 0) {
+            auto parent = (i - 1) / D;
+            if (!before(entry, this->heap[parent]))
+                break;
+            this->heap[i] = std::move(this->heap[parent]);
+            i = parent;
+        }
+        this->heap[i] = std::move(entry);
+    }
+
+    template <typename T, typename Compare>
+    void PriorityBuffer<T, Compare>::sift_down(std::size_t i) {
+        auto entry = std::move(this->heap[i]);
+        auto size = this->heap.size();
+        while (D * i + 1 < size) {
+            // Find the first child to be popped
+            auto first = D * i + 1;
+            auto last = std::min(first + D, size);
+            auto child = first;
+            for (auto j = first + 1; j < last; j++) {
+                if (before(this->heap[j], this->heap[child]))
+                    child = j;
+            }
+
+            if (!before(this->heap[child], entry))
+                break;
+            this->heap[i] = std::move(this->heap[child]);
+            i = child;
+        }
+        this->heap[i] = std::move(entry);
+    }
+
+    template <typename T, typename Compare>
+    std::size_t PriorityBuffer<T, Compare>::last() const {
+        auto size = this->heap.size();
+        auto leaf = size > 1 ? (size - 2) / D + 1 : 0;
+        for (auto j = leaf + 1; j < size; j++) {
+            if (before(this->heap[leaf], this->heap[j]))
+                leaf = j;
+        }
+        return leaf;
+    }
+
+    template <typename T, typename Compare>
+    bool PriorityBuffer<T, Compare>::empty() const {
+        return this->heap.empty();
+    }
+
+    template <typename T, typename Compare>
+    T PriorityBuffer<T, Compare>::take() {
+        T item = std::move(this->heap.front().item);
+        this->heap.front() = std::move(this->heap.back());
+        this->heap.pop_back();
+        if (!this->heap.empty())
+            sift_down(0);
+        else
+            this->drained();
+        return item;
+    }
+
+    template <typename T, typename Compare>
+    void PriorityBuffer<T, Compare>::push(T&& item) {
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            // Apply overflow policy if heap is full
+            if (this->heap.size() >= this->n) {
+                switch (policy) {
+                case Overflow::block:
+                    this->available[1].wait(
+                        lock, [this] { return this->heap.size() < this->n; });
+                    break;
+                case Overflow::drop_newest:
+                    this->discarded++;
+                    return;
+                case Overflow::drop_oldest: {
+                    // Replace the entry popped last, unless the item
+                    // would be popped after it
+                    Entry entry{std::forward<T>(item), this->seq++};
+                    this->discarded++;
+                    if (this->heap.empty())
+                        return;
+                    auto i = last();
+                    if (!before(entry, this->heap[i]))
+                        return;
+                    this->heap[i] = std::move(entry);
+                    sift_up(i);
+                    return;
+                }
+                case Overflow::fail:
+                    throw std::runtime_error("buffer is full");
+                }
+            }
+
+            // Push item to heap
+            this->heap.push_back(Entry{std::forward<T>(item), this->seq++});
+            sift_up(this->heap.size() - 1);
+            if (this->heap.size() == 1)
+                this->filled();
+        }
+        // Notify a waiting receiver
         this->available[0].notify_one();
+    }
 
+    template <typename T, typename Compare>
+    T PriorityBuffer<T, Compare>::pop() {
+        T item;
         {
-            // Reacquire lock
+            // Acquire lock
             auto lock = std::unique_lock(this->mutex);
 
-            // Block sender until item has been received
-            this->available[2].wait(lock, [this] { return !this->item; });
+            // Block receiver if heap is empty
+            this->available[0].wait(lock,
+                                    [this] { return !this->heap.empty(); });
+
+            // Pop item from heap
+            item = take();
+        }
+        // Notify a waiting sender
+        this->available[1].notify_one();
+
+        return item;
+    }
+
+    template <typename T, typename Compare>
+    std::optional<T> PriorityBuffer<T, Compare>::try_pop() {
+        std::optional<T> item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            if (this->heap.empty())
+                return std::nullopt;
+            item = take();
+        }
+        // Notify a waiting sender
+        this->available[1].notify_one();
+
+        return item;
+    }
+
+    template <typename T>
+    void ElasticBuffer<T>::resize(std::unique_lock<std::mutex>& lock,
+                                  std::size_t size) {
+        lock.unlock();
+        std::vector<T> storage(size);
+        lock.lock();
+
+        // Other threads ran meanwhile
+        if (this->count > size || this->ring.size() == size)
+            return;
+        for (std::size_t i = 0; i < this->count; i++) {
+            storage[i] =
+                std::move(this->ring[(this->head + i) % this->ring.size()]);
+        }
+        this->ring.swap(storage);
+        this->head = 0;
+        this->calm = 0;
+
+        lock.unlock();
+        storage = {};
+        lock.lock();
+    }
+
+    template <typename T> bool ElasticBuffer<T>::empty() const {
+        return this->count == 0;
+    }
+
+    template <typename T> T ElasticBuffer<T>::take() {
+        T item = std::move(this->ring[this->head]);
+        this->head = (this->head + 1) % this->ring.size();
+        this->count--;
+
+        if (this->count == 0)
+            this->drained();
+        return item;
+    }
+
+    template <typename T> bool ElasticBuffer<T>::settle() {
+        if (this->ring.size() <= this->soft)
+            return false;
+
+        auto now = std::chrono::steady_clock::now();
+        if (this->count > this->soft) {
+            this->calm = 0;
+            this->busy = now;
+            return false;
+        }
+        return ++this->calm >= this->hysteresis ||
+               now - this->busy >= this->linger;
+    }
+
+    template <typename T> void ElasticBuffer<T>::push(T&& item) {
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            for (;;) {
+                // Apply overflow policy if buffer is at its hard capacity
+                if (this->count >= this->hard) {
+                    switch (policy) {
+                    case Overflow::block:
+                        this->available[1].wait(lock, [this] {
+                            return this->count < this->hard;
+                        });
+                        break;
+                    case Overflow::drop_newest:
+                        this->discarded++;
+                        return;
+                    case Overflow::drop_oldest:
+                        // Overwrite the oldest slot
+                        this->head = (this->head + 1) % this->ring.size();
+                        this->count--;
+                        this->discarded++;
+                        break;
+                    case Overflow::fail:
+                        throw std::runtime_error("buffer is full");
+                    }
+                }
+                if (this->count < this->ring.size())
+                    break;
+
+                // Grow storage if full
+                resize(lock, std::min(this->ring.size() * 2, this->hard));
+            }
+
+            // Push item to ring
+            auto tail = (this->head + this->count++) % this->ring.size();
+            this->ring[tail] = std::forward<T>(item);
+            if (this->count == 1)
+                this->filled();
+            if (settle())
+                resize(lock, this->soft);
+        }
+        // Notify a waiting receiver
+        this->available[0].notify_one();
+    }
+
+    template <typename T> T ElasticBuffer<T>::pop() {
+        T item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            // Block receiver if buffer is empty, waking to shrink
+            // storage once it has lingered
+            while (this->count == 0) {
+                if (this->ring.size() <= this->soft)
+                    this->available[0].wait(lock);
+                else if (this->available[0].wait_until(
+                             lock, this->busy + this->linger) ==
+                             std::cv_status::timeout &&
+                         this->count == 0 && settle())
+                    resize(lock, this->soft);
+            }
+
+            // Pop item from ring
+            item = take();
+            if (settle())
+                resize(lock, this->soft);
         }
+        // Notify a waiting sender
+        this->available[1].notify_one();
+
+        return item;
+    }
+
+    template <typename T> std::optional<T> ElasticBuffer<T>::try_pop() {
+        std::optional<T> item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            if (this->count == 0) {
+                if (settle())
+                    resize(lock, this->soft);
+                return std::nullopt;
+            }
+            item = take();
+            if (settle())
+                resize(lock, this->soft);
+        }
+        // Notify a waiting sender
+        this->available[1].notify_one();
+
+        return item;
+    }
+
+    template <typename T> std::size_t ElasticBuffer<T>::capacity() const {
+        auto lock = std::unique_lock(this->mutex);
+        return this->ring.size();
+    }
+
+    template <typename T> bool RendezvousBuffer<T>::empty() const {
+        return !this->item.has_value();
+    }
+
+    template <typename T> T RendezvousBuffer<T>::take() {
+        T item = std::move(*this->item);
+        this->item.reset();
+        this->drained();
+        return item;
     }
 
     template <typename T> void RendezvousBuffer<T>::push(T&& item) {
@@ -337,6 +1245,7 @@ namespace piper::internal {
 
             // Push item to queue
             this->item = std::forward<T>(item);
+            this->filled();
         }
 
         // Notify a waiting receiver that buffer is filled
@@ -358,11 +1267,30 @@ namespace piper::internal {
             auto lock = std::unique_lock(this->mutex);
 
             // Block receiver until buffer is filled
-            this->available[0].wait(lock, [this] { return this->item; });
+            this->available[0].wait(lock,
+                                    [this] { return this->item.has_value(); });
 
             // Pop item from queue
-            item = *this->item;
-            this->item.reset();
+            item = take();
+        }
+
+        // Notify sender that item is received
+        this->available[2].notify_one();
+
+        // Notify a waiting sender
+        this->available[1].notify_one();
+        return item;
+    }
+
+    template <typename T> std::optional<T> RendezvousBuffer<T>::try_pop() {
+        std::optional<T> item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            if (!this->item)
+                return std::nullopt;
+            item = take();
         }
 
         // Notify sender that item is received
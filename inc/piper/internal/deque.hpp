@@ -0,0 +1,185 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @internal
+ * @file		deque.hpp
+ * @brief		Lock-free work-stealing deque
+ * @author		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date		2026-10-16
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace piper::internal {
+    /**
+     * @class 	WorkDeque
+     * @brief 	A Chase-Lev work-stealing deque
+     * @details The owning thread pushes and pops at the bottom, and
+     * 			any other thread steals from the top. Only a pop
+     * 			racing a steal for the last item needs a
+     * 			compare-and-swap. The ring doubles when full;
+     * 			retired rings are kept until the deque is destroyed,
+     * 			since a thief may still be reading them.
+     * @tparam 	T The type of item, which must be trivially copyable
+     */
+    template <typename T> class WorkDeque final {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "WorkDeque items must be trivially copyable");
+
+            /// A power-of-two ring of items
+            struct Ring {
+                    std::int64_t mask;
+                    std::unique_ptr<std::atomic<T>[]> items;
+
+                    explicit Ring(std::int64_t n)
+                        : mask(n - 1), items(new std::atomic<T>[n]) {}
+
+                    T get(std::int64_t i) const {
+                        return items[i & mask].load(std::memory_order_relaxed);
+                    }
+
+                    void put(std::int64_t i, T item) {
+                        items[i & mask].store(item, std::memory_order_relaxed);
+                    }
+            };
+
+            alignas(64) std::atomic<std::int64_t> top{0};
+            alignas(64) std::atomic<std::int64_t> bottom{0};
+            std::atomic<Ring*> ring;
+
+            /// Every ring allocated, owned by the deque
+            std::vector<std::unique_ptr<Ring>> rings;
+
+        public:
+            /**
+             * @brief 	Constructs a WorkDeque
+             * @param 	n The initial capacity, a power of two
+             */
+            explicit WorkDeque(std::size_t n = 256);
+
+            WorkDeque(const WorkDeque<T>&) = delete;
+            WorkDeque(WorkDeque<T>&&) = delete;
+
+            /**
+             * @brief 	Pushes an item onto the bottom of the deque
+             * @param 	item The item being pushed
+             * @note 	Only the owning thread may call this method
+             */
+            void push(T item);
+
+            /**
+             * @brief 	Pops the most recently pushed item
+             * @return 	The item, or std::nullopt if the deque is empty
+             * @note 	Only the owning thread may call this method
+             */
+            std::optional<T> pop();
+
+            /**
+             * @brief 	Steals the least recently pushed item
+             * @return 	The item, or std::nullopt if the deque is empty
+             * 			or another thread took the item first
+             * @note 	Any thread may call this method
+             */
+            std::optional<T> steal();
+    };
+
+    template <typename T> WorkDeque<T>::WorkDeque(std::size_t n) {
+        rings.push_back(std::make_unique<Ring>(static_cast<std::int64_t>(n)));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    template <typename T> void WorkDeque<T>::push(T item) {
+        auto b = bottom.load(std::memory_order_relaxed);
+        auto t = top.load(std::memory_order_acquire);
+        auto r = ring.load(std::memory_order_relaxed);
+
+        // Grow the ring when full
+        if (b - t > r->mask) {
+            auto grown = std::make_unique<Ring>(2 * (r->mask + 1));
+            for (auto i = t; i < b; i++) {
+                grown->put(i, r->get(i));
+            }
+            r = grown.get();
+            rings.push_back(std::move(grown));
+            ring.store(r, std::memory_order_release);
+        }
+
+        r->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    template <typename T> std::optional<T> WorkDeque<T>::pop() {
+        auto b = bottom.load(std::memory_order_relaxed) - 1;
+        auto r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // Empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        std::optional<T> item = r->get(b);
+        if (t == b) {
+            // Last item; race thieves for it
+            if (!top.compare_exchange_strong(t, t + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                item.reset();
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    template <typename T> std::optional<T> WorkDeque<T>::steal() {
+        auto t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return std::nullopt;
+
+        auto r = ring.load(std::memory_order_acquire);
+        T item = r->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return item;
+    }
+} // namespace piper::internal
@@ -0,0 +1,124 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @internal
+ * @file		freelist.hpp
+ * @brief		Lock-free free list of slot indices
+ * @author		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date		2026-10-16
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace piper::internal {
+    /**
+     * @class 	FreeList
+     * @brief 	A bounded, lock-free stack of slot indices
+     * @details The stack is threaded through a fixed array of next links,
+     * 			and the head carries a generation tag alongside the index
+     * 			to guard the compare-and-swap against ABA.
+     */
+    class FreeList final {
+            /// Sentinel index marking the end of the list
+            static constexpr std::uint32_t npos = UINT32_MAX;
+
+            /// Next links, one per slot
+            std::unique_ptr<std::atomic<std::uint32_t>[]> next;
+
+            /// Packed generation tag (high word) and head index (low word)
+            alignas(64) std::atomic<std::uint64_t> head;
+
+            static std::uint64_t pack(std::uint64_t tag, std::uint32_t index) {
+                return (tag << 32) | index;
+            }
+
+            static std::uint32_t index(std::uint64_t word) {
+                return static_cast<std::uint32_t>(word);
+            }
+
+            static std::uint64_t tag(std::uint64_t word) { return word >> 32; }
+
+        public:
+            /**
+             * @brief 	Constructs a free list holding every index in [0, n)
+             * @param 	n The number of slots
+             */
+            explicit FreeList(std::uint32_t n);
+
+            FreeList(const FreeList&) = delete;
+            FreeList(FreeList&&) = delete;
+
+            /**
+             * @brief 	Pops a free slot index
+             * @return 	The index, or std::nullopt if every slot is in use
+             * @note 	This method does not block
+             */
+            std::optional<std::uint32_t> pop();
+
+            /**
+             * @brief 	Pushes a slot index back onto the list
+             * @param 	i The index being released
+             * @note 	This method does not block
+             */
+            void push(std::uint32_t i);
+    };
+
+    inline FreeList::FreeList(std::uint32_t n)
+        : next(new std::atomic<std::uint32_t>[n]) {
+        for (std::uint32_t i = 0; i < n; i++) {
+            next[i].store(i + 1 < n ? i + 1 : npos, std::memory_order_relaxed);
+        }
+        head.store(pack(0, n > 0 ? 0 : npos), std::memory_order_release);
+    }
+
+    inline std::optional<std::uint32_t> FreeList::pop() {
+        auto old = head.load(std::memory_order_acquire);
+        while (index(old) != npos) {
+            auto successor = next[index(old)].load(std::memory_order_relaxed);
+            if (head.compare_exchange_weak(old, pack(tag(old) + 1, successor),
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+                return index(old);
+            }
+        }
+        return std::nullopt;
+    }
+
+    inline void FreeList::push(std::uint32_t i) {
+        auto old = head.load(std::memory_order_relaxed);
+        do {
+            next[i].store(index(old), std::memory_order_relaxed);
+        } while (!head.compare_exchange_weak(old, pack(tag(old) + 1, i),
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+    }
+} // namespace piper::internal
@@ -0,0 +1,605 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @internal
+ * @file		log.hpp
+ * @brief		Durable buffer backed by a segmented, append-only log
+ * @author		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "piper/codec.hpp"
+#include "piper/internal/buffer.hpp"
+
+namespace piper::internal {
+    /**
+     * @class 	LogSegment
+     * @brief 	A memory-mapped log file holding checksummed records
+     * @details Each record is a 32-bit length and a 32-bit checksum
+     * 			followed by the payload. The length field holds the
+     * 			payload size plus one, so that an empty payload is
+     * 			still a record, and a zero length marks the end of the
+     * 			records in a segment.
+     */
+    class LogSegment {
+            std::string path;
+            int fd = -1;
+            std::byte* base = nullptr;
+            std::size_t length = 0;
+
+        public:
+            /// The size of a record header in bytes
+            static constexpr std::size_t header = 2 * sizeof(std::uint32_t);
+
+            /**
+             * @brief 	Opens a segment file, creating it if needed
+             * @param 	path The path of the segment file
+             * @param 	size The size of a new segment file
+             * @throws 	std::system_error Thrown if the file cannot be
+             * 			opened or mapped
+             */
+            LogSegment(std::string path, std::size_t size);
+
+            LogSegment(LogSegment&& segment);
+            LogSegment(const LogSegment&) = delete;
+
+            ~LogSegment();
+
+            /// Gets the size of the segment in bytes
+            std::size_t size() const { return length; }
+
+            /**
+             * @brief 	Writes a record at a position
+             * @param 	position The offset of the record in the segment
+             * @param 	payload The record payload
+             * @note 	The caller ensures the record fits
+             */
+            void write(std::size_t position,
+                       std::span<const std::byte> payload);
+
+            /**
+             * @brief 	Reads the record at a position
+             * @param 	position The offset of the record in the segment
+             * @return 	The payload, or std::nullopt if no valid record
+             * 			starts at position
+             */
+            std::optional<std::span<const std::byte>>
+            read(std::size_t position) const;
+
+            /**
+             * @brief 	Zeroes the segment from a position onwards
+             * @param 	position The offset to clear from
+             */
+            void clear(std::size_t position);
+
+            /**
+             * @brief 	Flushes a range of the segment to disk
+             * @param 	from The first offset to flush
+             * @param 	to The offset past the last byte to flush
+             */
+            void sync(std::size_t from, std::size_t to);
+
+            /**
+             * @brief 	Deletes the segment file
+             */
+            void remove() { unlink(path.c_str()); }
+
+            /// Computes the checksum of a record
+            static std::uint32_t checksum(std::span<const std::byte> payload);
+    };
+
+    inline LogSegment::LogSegment(std::string path, std::size_t size)
+        : path(std::move(path)) {
+        fd = open(this->path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "open");
+
+        struct stat info;
+        if (fstat(fd, &info) < 0 ||
+            (info.st_size == 0 &&
+             ftruncate(fd, static_cast<off_t>(size)) < 0)) {
+            auto error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(),
+                                    "ftruncate");
+        }
+        length = info.st_size ? static_cast<std::size_t>(info.st_size) : size;
+
+        auto address =
+            mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            auto error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        base = static_cast<std::byte*>(address);
+    }
+
+    inline LogSegment::LogSegment(LogSegment&& segment)
+        : path(std::move(segment.path)), fd(segment.fd), base(segment.base),
+          length(segment.length) {
+        segment.fd = -1;
+        segment.base = nullptr;
+    }
+
+    inline LogSegment::~LogSegment() {
+        if (base)
+            munmap(base, length);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    inline std::uint32_t
+    LogSegment::checksum(std::span<const std::byte> payload) {
+        // FNV-1a
+        std::uint32_t hash = 2166136261u;
+        for (auto byte : payload) {
+            hash ^= static_cast<std::uint32_t>(byte);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    inline void LogSegment::write(std::size_t position,
+                                  std::span<const std::byte> payload) {
+        std::uint32_t fields[2] = {
+            static_cast<std::uint32_t>(payload.size() + 1), checksum(payload)};
+        std::memcpy(base + position + header, payload.data(), payload.size());
+        std::memcpy(base + position, fields, header);
+    }
+
+    inline std::optional<std::span<const std::byte>>
+    LogSegment::read(std::size_t position) const {
+        if (position + header > length)
+            return std::nullopt;
+
+        std::uint32_t fields[2];
+        std::memcpy(fields, base + position, header);
+        if (fields[0] == 0 || position + header + fields[0] - 1 > length)
+            return std::nullopt;
+
+        auto payload = std::span<const std::byte>(base + position + header,
+                                                  fields[0] - 1);
+        if (checksum(payload) != fields[1])
+            return std::nullopt;
+        return payload;
+    }
+
+    inline void LogSegment::clear(std::size_t position) {
+        if (position < length)
+            std::memset(base + position, 0, length - position);
+    }
+
+    inline void LogSegment::sync(std::size_t from, std::size_t to) {
+        auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        from -= from % page;
+        if (to > from)
+            msync(base + from, to - from, MS_SYNC);
+    }
+
+    /**
+     * @class 	LogBuffer
+     * @brief 	A durable, unbounded buffer backed by an append-only log
+     * @details Items are serialized into a directory of memory-mapped,
+     * 			fixed-size segment files. Appends and the consumer
+     * 			offset are flushed to disk together once every batch
+     * 			items or interval, whichever comes first, so one fsync
+     * 			covers a group of items. Popping an item acknowledges
+     * 			every item popped before it. When a LogBuffer is
+     * 			reopened on the same directory, unacknowledged items
+     * 			are replayed, so delivery is at least once. Segments
+     * 			are deleted once every item in them is acknowledged.
+     * @tparam 	T The type of item stored in the buffer
+     * @tparam 	Codec The serializer for items
+     * @extends Buffer
+     * @note 	Items pushed since the last group commit may be lost
+     * 			if the machine crashes; call sync() to flush them.
+     */
+    template <typename T, typename Codec = piper::Codec<T>>
+    class LogBuffer final : public Buffer<T> {
+            using Clock = std::chrono::steady_clock;
+
+            std::string directory;
+            std::size_t segment;
+            std::size_t batch;
+            Clock::duration interval;
+
+            /// Segments by the log offset of their first byte
+            std::map<std::uint64_t, LogSegment> segments;
+
+            /// Log offset of the next record to write
+            std::uint64_t tail = 0;
+
+            /// Log offset of the next record to pop
+            std::uint64_t cursor = 0;
+
+            /// Log offset of the oldest unacknowledged record
+            std::uint64_t acked = 0;
+
+            /// Log offset up to which appends are on disk
+            std::uint64_t synced = 0;
+
+            /// Items pushed or popped since the last group commit
+            std::size_t pending = 0;
+            Clock::time_point committed = Clock::now();
+
+            /// The durable consumer offset file
+            int offsets = -1;
+
+            /// The log directory, flushed as segments come and go
+            int folder = -1;
+
+            std::vector<std::byte> scratch;
+            std::condition_variable available;
+
+            /// Checks whether the buffer holds no items
+            bool empty() const override { return cursor == tail; }
+
+            /**
+             * @brief 	Removes the next item, with the buffer lock held
+             * @throws 	std::runtime_error Thrown if the records up to
+             * 			the tail are unreadable, which are skipped
+             */
+            T take();
+
+            /**
+             * @brief 	Flushes the directory, so that created and
+             * 			deleted segments survive a crash
+             * @throws 	std::system_error Thrown if it cannot be flushed
+             */
+            void sync_directory();
+
+            /// Gets the path of the segment starting at a log offset
+            std::string path(std::uint64_t base) const;
+
+            /// Gets the segment holding a log offset
+            std::map<std::uint64_t, LogSegment>::iterator
+            locate(std::uint64_t offset);
+
+            /// Flushes appends and the consumer offset, with the lock held
+            void commit();
+
+            /// Commits if a batch is full or the interval has passed
+            void maybe_commit();
+
+        public:
+            /**
+             * @brief 	Opens or creates a log buffer
+             * @param 	directory An existing directory for the log
+             * @param 	segment The size of each segment file in bytes
+             * @param 	batch The number of operations per group commit
+             * @param 	interval The maximum time between group commits
+             * @throws 	std::system_error Thrown if the log cannot be
+             * 			opened
+             */
+            LogBuffer(std::string directory,
+                      std::size_t segment = std::size_t(1) << 26,
+                      std::size_t batch = 256,
+                      Clock::duration interval = std::chrono::milliseconds(10));
+
+            LogBuffer(const LogBuffer<T, Codec>&) = delete;
+            LogBuffer(LogBuffer<T, Codec>&&) = delete;
+
+            /**
+             * @brief 	Destructs a LogBuffer, flushing it to disk
+             */
+            ~LogBuffer();
+
+            using Buffer<T>::push;
+
+            /**
+             * @brief 	Moves and pushes an item into the buffer
+             * @param 	item The item being pushed into the buffer
+             * @throws 	std::runtime_error Thrown if the serialized item
+             * 			does not fit in a segment
+             * @note 	Blocks only while a group commit is flushed
+             */
+            void push(T&& item) override;
+
+            /**
+             * @brief 	Pops an item from the buffer
+             * @return 	The item being popped from the buffer
+             * @throws 	std::runtime_error Thrown if the log is corrupt
+             * @note 	Blocks on an empty buffer, and acknowledges
+             * 			every item popped before it
+             */
+            T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @throws 	std::runtime_error Thrown if the log is corrupt
+             * @note 	Acknowledges every item popped before it
+             */
+            std::optional<T> try_pop() override;
+
+            /**
+             * @brief 	Acknowledges every item popped so far
+             */
+            void acknowledge();
+
+            /**
+             * @brief 	Flushes appends and the consumer offset to disk
+             */
+            void sync();
+    };
+
+    template <typename T, typename Codec>
+    LogBuffer<T, Codec>::LogBuffer(std::string directory, std::size_t segment,
+                                   std::size_t batch, Clock::duration interval)
+        : directory(std::move(directory)), segment(segment), batch(batch),
+          interval(interval) {
+        // Load the durable consumer offset
+        auto offset_path = this->directory + "/consumer.offset";
+        offsets = open(offset_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (offsets < 0)
+            throw std::system_error(errno, std::generic_category(), "open");
+        if (pread(offsets, &acked, sizeof(acked), 0) != sizeof(acked))
+            acked = 0;
+        folder = open(this->directory.c_str(),
+                      O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (folder < 0) {
+            auto error = errno;
+            close(offsets);
+            throw std::system_error(error, std::generic_category(), "open");
+        }
+
+        // Map the existing segments
+        if (auto dir = opendir(this->directory.c_str())) {
+            while (auto entry = readdir(dir)) {
+                std::uint64_t base;
+                char suffix[8];
+                if (std::sscanf(entry->d_name, "%" SCNu64 ".%7s", &base,
+                                suffix) == 2 &&
+                    std::strcmp(suffix, "log") == 0) {
+                    segments.emplace(base, LogSegment(path(base), segment));
+                }
+            }
+            closedir(dir);
+        }
+
+        if (segments.empty()) {
+            segments.emplace(acked, LogSegment(path(acked), segment));
+            tail = acked;
+        } else {
+            // Find the end of the records in the newest segment
+            auto& [base, newest] = *segments.rbegin();
+            std::size_t position = 0;
+            while (auto payload = newest.read(position)) {
+                position += LogSegment::header + payload->size();
+            }
+            newest.clear(position);
+            tail = base + position;
+        }
+
+        acked = std::max(acked, segments.begin()->first);
+        cursor = acked;
+        synced = tail;
+        sync_directory();
+    }
+
+    template <typename T, typename Codec> LogBuffer<T, Codec>::~LogBuffer() {
+        auto lock = std::unique_lock(this->mutex);
+        commit();
+        close(offsets);
+        close(folder);
+    }
+
+    template <typename T, typename Codec>
+    void LogBuffer<T, Codec>::sync_directory() {
+        if (fsync(folder) < 0)
+            throw std::system_error(errno, std::generic_category(), "fsync");
+    }
+
+    template <typename T, typename Codec>
+    std::string LogBuffer<T, Codec>::path(std::uint64_t base) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%020" PRIu64 ".log", base);
+        return directory + "/" + name;
+    }
+
+    template <typename T, typename Codec>
+    std::map<std::uint64_t, LogSegment>::iterator
+    LogBuffer<T, Codec>::locate(std::uint64_t offset) {
+        return std::prev(segments.upper_bound(offset));
+    }
+
+    template <typename T, typename Codec> void LogBuffer<T, Codec>::commit() {
+        // Flush appends since the last commit
+        for (auto it = locate(synced); it != segments.end(); it++) {
+            auto& [base, log] = *it;
+            auto from = synced > base ? synced - base : 0;
+            auto to = std::min<std::uint64_t>(tail - base, log.size());
+            log.sync(from, to);
+        }
+        synced = tail;
+
+        // Flush the consumer offset
+        if (pwrite(offsets, &acked, sizeof(acked), 0) == sizeof(acked))
+            fdatasync(offsets);
+
+        // Delete fully acknowledged segments, keeping the newest
+        auto removed = false;
+        while (segments.size() > 1) {
+            auto& [base, oldest] = *segments.begin();
+            if (base + oldest.size() > acked)
+                break;
+            oldest.remove();
+            segments.erase(segments.begin());
+            removed = true;
+        }
+        if (removed)
+            fsync(folder);
+
+        pending = 0;
+        committed = Clock::now();
+    }
+
+    template <typename T, typename Codec>
+    void LogBuffer<T, Codec>::maybe_commit() {
+        if (++pending >= batch || Clock::now() - committed >= interval)
+            commit();
+    }
+
+    template <typename T, typename Codec> T LogBuffer<T, Codec>::take() {
+        // Acknowledge the items popped so far
+        acked = cursor;
+
+        auto it = locate(cursor);
+        auto payload = it->second.read(cursor - it->first);
+        while (!payload) {
+            // The rest of this segment is unused; move to the next
+            if (++it == segments.end()) {
+                // A record before the tail is corrupt, and so is
+                // everything after it
+                cursor = tail;
+                this->drained();
+                throw std::runtime_error("log record is corrupt");
+            }
+            cursor = it->first;
+            payload = it->second.read(0);
+        }
+
+        T item = Codec::decode(*payload);
+        cursor += LogSegment::header + payload->size();
+        if (cursor == tail)
+            this->drained();
+
+        maybe_commit();
+        return item;
+    }
+
+    template <typename T, typename Codec>
+    void LogBuffer<T, Codec>::push(T&& item) {
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+            auto was_empty = empty();
+
+            // Serialize item
+            scratch.clear();
+            Codec::encode(item, scratch);
+            auto size = LogSegment::header + scratch.size();
+            if (size > segment)
+                throw std::runtime_error("item exceeds segment size");
+
+            // Roll to a new segment if the record does not fit
+            auto it = locate(tail);
+            if (tail - it->first + size > it->second.size()) {
+                auto base = it->first + it->second.size();
+                segments.emplace(base, LogSegment(path(base), segment));
+                sync_directory();
+                tail = base;
+            }
+
+            // Append record to log
+            auto& [base, log] = *locate(tail);
+            log.write(tail - base, scratch);
+            tail += size;
+
+            if (was_empty)
+                this->filled();
+            maybe_commit();
+        }
+
+        this->available.notify_one();
+    }
+
+    template <typename T, typename Codec> T LogBuffer<T, Codec>::pop() {
+        T item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            // Block receiver if log is empty
+            this->available.wait(lock, [this] { return !empty(); });
+
+            // Pop item from log
+            item = take();
+        }
+        return item;
+    }
+
+    template <typename T, typename Codec>
+    std::optional<T> LogBuffer<T, Codec>::try_pop() {
+        // Acquire lock
+        auto lock = std::unique_lock(this->mutex);
+
+        if (empty())
+            return std::nullopt;
+        return take();
+    }
+
+    template <typename T, typename Codec>
+    void LogBuffer<T, Codec>::acknowledge() {
+        auto lock = std::unique_lock(this->mutex);
+        acked = cursor;
+        maybe_commit();
+    }
+
+    template <typename T, typename Codec> void LogBuffer<T, Codec>::sync() {
+        auto lock = std::unique_lock(this->mutex);
+        commit();
+    }
+} // namespace piper::internal
+
+namespace piper::flavor {
+    /**
+     * @struct 	Log
+     * @brief 	Selects a durable buffer backed by an append-only log
+     * @tparam 	Codec The serializer for items, by default piper::Codec
+     */
+    template <template <typename> typename Codec = piper::Codec> struct Log {
+            template <typename T>
+            using Buffer = internal::LogBuffer<T, Codec<T>>;
+    };
+} // namespace piper::flavor
@@ -0,0 +1,979 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @internal
+ * @file		sharded.hpp
+ * @brief		Buffers sharded into a lock-free lane per endpoint
+ * @author		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "piper/internal/buffer.hpp"
+#include "piper/numa.hpp"
+
+namespace piper::internal {
+    /**
+     * @class 	Lane
+     * @brief 	A bounded, lock-free, single producer, single consumer
+     * 			ring
+     * @details Each side keeps a private copy of the other side's
+     * 			index and only reloads it when the ring looks full or
+     * 			empty, so the two sides rarely share a cache line.
+     * @tparam 	T The type of item stored in the lane
+     */
+    template <typename T> class Lane final {
+            std::size_t mask;
+            PlacedArray<std::optional<T>> slots;
+
+            /// Consumer index, and the consumer's copy of tail
+            alignas(64) std::atomic<std::size_t> head{0};
+            std::size_t tail_cache = 0;
+
+            /// Set by a producer waiting for room
+            std::atomic<bool> blocked{false};
+
+            /// Producer index, and the producer's copy of head
+            alignas(64) std::atomic<std::size_t> tail{0};
+            std::size_t head_cache = 0;
+
+        public:
+            /**
+             * @brief 	Constructs a Lane
+             * @param 	n The capacity, rounded up to a power of two
+             * @param 	placement Where the slots should live
+             */
+            explicit Lane(std::size_t n, Placement placement = {})
+                : mask(std::bit_ceil(std::max<std::size_t>(n, 1)) - 1),
+                  slots(mask + 1, placement) {}
+
+            /**
+             * @brief 	Moves an item into the lane, if there is room
+             * @param 	item The item, moved from only on success
+             * @return 	Whether the item was pushed
+             * @note 	Only the producer may call this method
+             */
+            bool try_push(T& item);
+
+            /**
+             * @brief 	Blocks until the lane has room
+             * @note 	Only the producer may call this method
+             */
+            void wait();
+
+            /**
+             * @brief 	Pops the oldest item, if there is one
+             * @return 	The item, or std::nullopt if the lane is empty
+             * @note 	Only the consumer may call this method
+             */
+            std::optional<T> try_pop();
+
+            /**
+             * @brief 	Checks whether the lane holds no items
+             */
+            bool empty() const {
+                return head.load(std::memory_order_acquire) ==
+                       tail.load(std::memory_order_acquire);
+            }
+    };
+
+    template <typename T> bool Lane<T>::try_push(T& item) {
+        auto t = tail.load(std::memory_order_relaxed);
+        if (t - head_cache > mask) {
+            head_cache = head.load(std::memory_order_acquire);
+            if (t - head_cache > mask)
+                return false;
+        }
+        slots[t & mask].emplace(std::move(item));
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T> void Lane<T>::wait() {
+        auto h = head.load(std::memory_order_seq_cst);
+        blocked.store(true, std::memory_order_seq_cst);
+        if (tail.load(std::memory_order_relaxed) - h > mask)
+            head.wait(h, std::memory_order_seq_cst);
+    }
+
+    template <typename T> std::optional<T> Lane<T>::try_pop() {
+        auto h = head.load(std::memory_order_relaxed);
+        if (h == tail_cache) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if (h == tail_cache)
+                return std::nullopt;
+        }
+        std::optional<T> item = std::move(slots[h & mask]);
+        slots[h & mask].reset();
+
+        // Pairs with wait(): either the producer sees the new head, or
+        // this thread sees the producer blocked
+        head.store(h + 1, std::memory_order_seq_cst);
+        if (blocked.load(std::memory_order_seq_cst)) {
+            blocked.store(false, std::memory_order_relaxed);
+            head.notify_one();
+        }
+        return item;
+    }
+
+    /**
+     * @class 	Signal
+     * @brief 	A wake-up word shared by the lanes of a buffer
+     * @details The word counts wake-ups, and a separate count tracks
+     * 			the threads about to sleep. Threads that make progress
+     * 			only read the count, unless someone is sleeping.
+     */
+    class Signal final {
+            alignas(64) std::atomic<std::uint32_t> word{0};
+            std::atomic<std::uint32_t> sleepers{0};
+
+        public:
+            /**
+             * @brief 	Wakes every sleeping thread, if there are any
+             * @note 	Call after publishing the progress to wake for
+             */
+            void notify() {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (sleepers.load(std::memory_order_relaxed)) {
+                    word.fetch_add(1, std::memory_order_relaxed);
+                    word.notify_all();
+                }
+            }
+
+            /**
+             * @brief 	Sleeps until notified, unless ready
+             * @param 	ready Checks for progress after announcing sleep
+             */
+            template <typename F> void sleep(F&& ready) {
+                auto seen = word.load(std::memory_order_relaxed);
+                sleepers.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!ready())
+                    word.wait(seen, std::memory_order_relaxed);
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+            }
+    };
+
+    /**
+     * @class 	Readiness
+     * @brief 	Tells a listener when a lock-free buffer fills
+     * @details The consumer arms it on finding the buffer empty, and
+     * 			the first producer to publish an item afterwards
+     * 			disarms it and notifies the listener, so producers
+     * 			only take the lock once per empty to non-empty
+     * 			transition. Nothing is armed while no one listens.
+     */
+    class Readiness final {
+            std::mutex mutex;
+            std::shared_ptr<Listener> listener;
+            std::atomic<bool> listening{false};
+            std::atomic<bool> armed{false};
+
+            /// Also raised when armed, if shared with other consumers
+            std::atomic<bool>* any;
+
+            /// Arms, then rechecks for items published meanwhile
+            template <typename F> void arm(F& ready) {
+                armed.store(true, std::memory_order_seq_cst);
+                if (any)
+                    any->store(true, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (ready())
+                    fill();
+            }
+
+        public:
+            /**
+             * @brief 	Constructs a Readiness
+             * @param 	any A flag raised along with this one, which
+             * 			producers check before visiting each consumer
+             */
+            explicit Readiness(std::atomic<bool>* any = nullptr)
+                : any(any) {}
+
+            /**
+             * @brief 	Attaches a listener, notifying it if ready
+             * @param 	listener The listener, or nullptr to detach
+             * @param 	ready Checks whether the buffer holds items
+             */
+            template <typename F>
+            void listen(std::shared_ptr<Listener> listener, F ready) {
+                {
+                    auto lock = std::unique_lock(mutex);
+                    listening.store(listener != nullptr,
+                                    std::memory_order_relaxed);
+                    this->listener = std::move(listener);
+                }
+                if (listening.load(std::memory_order_relaxed))
+                    arm(ready);
+            }
+
+            /**
+             * @brief 	Notifies the listener that the buffer is empty
+             * @param 	ready Checks whether the buffer holds items
+             * @note 	Called by the consumer on finding no items
+             */
+            template <typename F> void drain(F ready) {
+                if (!listening.load(std::memory_order_relaxed) ||
+                    armed.load(std::memory_order_relaxed))
+                    return;
+                {
+                    auto lock = std::unique_lock(mutex);
+                    if (listener)
+                        listener->drained();
+                }
+                arm(ready);
+            }
+
+            /**
+             * @brief 	Notifies the listener that the buffer filled,
+             * 			if it is armed
+             * @note 	Call after publishing an item and a sequentially
+             * 			consistent fence, such as Signal::notify()
+             */
+            void fill() {
+                if (!armed.load(std::memory_order_relaxed) ||
+                    !armed.exchange(false, std::memory_order_seq_cst))
+                    return;
+                auto lock = std::unique_lock(mutex);
+                if (listener)
+                    listener->filled();
+            }
+    };
+
+    /**
+     * @class 	ShardedBuffer
+     * @brief 	A multiple producer, single consumer buffer with a
+     * 			lock-free lane per producer
+     * @details Each mpsc::Sender copied from the Receiver is attached
+     * 			to its own bounded single producer lane, so producers
+     * 			never write a shared cache line. The receiver polls
+     * 			the lanes round-robin and sleeps on a shared Signal
+     * 			when all are empty. Lanes of destructed Senders are
+     * 			removed once drained. Items from one Sender arrive in
+     * 			order; items from different Senders are interleaved.
+     * @tparam 	T The type of item stored in the buffer
+     * @extends Buffer
+     * @note 	A Sender blocks while its lane is full. A single Sender
+     * 			must not be used from several threads at once.
+     */
+    template <typename T> class ShardedBuffer final : public Buffer<T> {
+            /// The buffer a Sender pushes into
+            class Port final : public Buffer<T> {
+                    friend class ShardedBuffer<T>;
+
+                    Lane<T> lane;
+                    std::shared_ptr<Signal> signal;
+                    std::shared_ptr<Readiness> readiness;
+                    std::atomic<bool> closed{false};
+
+                    bool empty() const override { return lane.empty(); }
+
+                public:
+                    Port(std::size_t n, Placement placement,
+                         std::shared_ptr<Signal> signal,
+                         std::shared_ptr<Readiness> readiness)
+                        : lane(n, placement), signal(std::move(signal)),
+                          readiness(std::move(readiness)) {}
+
+                    using Buffer<T>::push;
+
+                    void push(T&& item) override {
+                        while (!lane.try_push(item)) {
+                            lane.wait();
+                        }
+                        signal->notify();
+                        readiness->fill();
+                    }
+
+                    T pop() override {
+                        throw std::logic_error("lanes are popped by "
+                                               "their buffer");
+                    }
+
+                    std::optional<T> try_pop() override { return pop(); }
+
+                    void detach() override {
+                        closed.store(true, std::memory_order_release);
+                    }
+            };
+
+            std::size_t n;
+            Placement placement;
+            std::shared_ptr<Signal> signal = std::make_shared<Signal>();
+            std::shared_ptr<Readiness> readiness =
+                std::make_shared<Readiness>();
+
+            /// Every attached port, guarded by the buffer lock
+            std::vector<std::shared_ptr<Port>> ports;
+            std::atomic<std::uint64_t> generation{0};
+
+            /// The port used by push() on the buffer itself
+            std::shared_ptr<Port> own;
+            std::mutex pushing;
+
+            /// The consumer's copy of ports
+            std::vector<std::shared_ptr<Port>> snapshot;
+            std::uint64_t seen = ~std::uint64_t(0);
+            std::size_t next = 0;
+
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Registers a port, with the buffer lock held
+            std::shared_ptr<Port> add();
+
+            /// Refreshes the consumer's copy of ports
+            void refresh();
+
+            /// Checks whether any lane holds items, from the consumer
+            bool ready();
+
+        public:
+            /**
+             * @brief 	Constructs a sharded buffer
+             * @param 	n The capacity of each lane
+             * @param 	placement Where each lane's slots should live
+             */
+            explicit ShardedBuffer(std::size_t n = 1024,
+                                   Placement placement = {})
+                : n(n), placement(placement) {}
+
+            ShardedBuffer(const ShardedBuffer<T>&) = delete;
+            ShardedBuffer(ShardedBuffer<T>&&) = delete;
+
+            /**
+             * @brief 	Attaches a new lane for a Sender
+             * @return 	The lane
+             */
+            std::shared_ptr<Buffer<T>>
+            attach(std::shared_ptr<Buffer<T>> self) override;
+
+            using Buffer<T>::push;
+
+            /**
+             * @brief 	Moves and pushes an item into the buffer
+             * @param 	item The item being pushed into the buffer
+             * @note 	Pushes through a lane shared under a lock; Senders
+             * 			use their own lanes instead
+             */
+            void push(T&& item) override;
+
+            /**
+             * @brief 	Pops an item from the buffer
+             * @return 	The item being popped from the buffer
+             * @note 	Blocks on an empty buffer
+             */
+            T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
+
+            /**
+             * @brief 	Attaches a readiness listener to the buffer
+             * @param 	listener The listener, or nullptr to detach
+             * @note 	Senders notify the listener without the buffer
+             * 			lock, once per empty to non-empty transition.
+             */
+            void listen(std::shared_ptr<Listener> listener) override {
+                readiness->listen(std::move(listener),
+                                  [this] { return ready(); });
+            }
+    };
+
+    template <typename T> bool ShardedBuffer<T>::empty() const {
+        for (auto& port : ports) {
+            if (!port->lane.empty())
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    std::shared_ptr<typename ShardedBuffer<T>::Port> ShardedBuffer<T>::add() {
+        auto port = std::make_shared<Port>(n, placement, signal, readiness);
+        ports.push_back(port);
+        generation.fetch_add(1, std::memory_order_release);
+        return port;
+    }
+
+    template <typename T> void ShardedBuffer<T>::refresh() {
+        if (generation.load(std::memory_order_acquire) == seen)
+            return;
+        auto lock = std::unique_lock(this->mutex);
+        snapshot = ports;
+        seen = generation.load(std::memory_order_relaxed);
+    }
+
+    template <typename T> bool ShardedBuffer<T>::ready() {
+        refresh();
+        return std::any_of(snapshot.begin(), snapshot.end(),
+                           [](auto& port) { return !port->lane.empty(); });
+    }
+
+    template <typename T>
+    std::shared_ptr<Buffer<T>>
+    ShardedBuffer<T>::attach(std::shared_ptr<Buffer<T>>) {
+        auto lock = std::unique_lock(this->mutex);
+        return add();
+    }
+
+    template <typename T> void ShardedBuffer<T>::push(T&& item) {
+        auto lock = std::unique_lock(this->pushing);
+        if (!own) {
+            auto registry = std::unique_lock(this->mutex);
+            own = add();
+        }
+        own->push(std::move(item));
+    }
+
+    template <typename T> std::optional<T> ShardedBuffer<T>::try_pop() {
+        refresh();
+
+        bool sweep = false;
+        for (std::size_t i = 0; i < snapshot.size(); i++) {
+            auto index = (next + i) % snapshot.size();
+            auto& port = snapshot[index];
+            auto closed = port->closed.load(std::memory_order_acquire);
+            if (auto item = port->lane.try_pop()) {
+                next = index + 1;
+                return item;
+            }
+            sweep |= closed;
+        }
+
+        // Remove drained lanes of destructed Senders
+        if (sweep) {
+            auto lock = std::unique_lock(this->mutex);
+            std::erase_if(ports, [](auto& port) {
+                return port->closed.load(std::memory_order_acquire) &&
+                       port->lane.empty();
+            });
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        readiness->drain([this] { return ready(); });
+        return std::nullopt;
+    }
+
+    template <typename T> T ShardedBuffer<T>::pop() {
+        while (true) {
+            if (auto item = try_pop())
+                return std::move(*item);
+
+            signal->sleep([this] { return ready(); });
+        }
+    }
+
+    /**
+     * @class 	SharedLane
+     * @brief 	A bounded, lock-free ring with a single producer and
+     * 			any number of consumers
+     * @details Each slot carries a sequence number, so a consumer
+     * 			that claims a slot by advancing head may move the item
+     * 			out before the producer reuses the slot.
+     * @tparam 	T The type of item stored in the lane
+     */
+    template <typename T> class SharedLane final {
+            struct Slot {
+                    std::atomic<std::size_t> sequence;
+                    std::optional<T> item;
+            };
+
+            std::size_t mask;
+            PlacedArray<Slot> slots;
+
+            alignas(64) std::atomic<std::size_t> head{0};
+            alignas(64) std::atomic<std::size_t> tail{0};
+
+        public:
+            /// Set once the consumer owning the lane is gone
+            std::atomic<bool> closed{false};
+
+            /**
+             * @brief 	Constructs a SharedLane
+             * @param 	n The capacity, rounded up to a power of two
+             * @param 	placement Where the slots should live
+             */
+            explicit SharedLane(std::size_t n, Placement placement = {});
+
+            /**
+             * @brief 	Moves an item into the lane, if there is room
+             * @param 	item The item, moved from only on success
+             * @return 	Whether the item was pushed
+             * @note 	Only the producer may call this method
+             */
+            bool try_push(T& item);
+
+            /**
+             * @brief 	Pops the oldest item, if there is one
+             * @return 	The item, or std::nullopt if the lane is empty
+             * @note 	Any thread may call this method
+             */
+            std::optional<T> try_pop();
+
+            /// Checks whether the lane holds no items
+            bool empty() const {
+                return head.load(std::memory_order_acquire) ==
+                       tail.load(std::memory_order_acquire);
+            }
+
+            /// Checks whether the lane has no room
+            bool full() const {
+                return tail.load(std::memory_order_acquire) -
+                           head.load(std::memory_order_acquire) >
+                       mask;
+            }
+    };
+
+    template <typename T>
+    SharedLane<T>::SharedLane(std::size_t n, Placement placement)
+        : mask(std::bit_ceil(std::max<std::size_t>(n, 1)) - 1),
+          slots(mask + 1, placement) {
+        for (std::size_t i = 0; i <= mask; i++) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T> bool SharedLane<T>::try_push(T& item) {
+        auto t = tail.load(std::memory_order_relaxed);
+        auto& slot = slots[t & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != t)
+            return false;
+
+        slot.item.emplace(std::move(item));
+        slot.sequence.store(t + 1, std::memory_order_release);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T> std::optional<T> SharedLane<T>::try_pop() {
+        auto h = head.load(std::memory_order_relaxed);
+        while (true) {
+            auto& slot = slots[h & mask];
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != h + 1) {
+                // Either empty, or another consumer took slot h
+                if (static_cast<std::ptrdiff_t>(sequence - (h + 1)) < 0)
+                    return std::nullopt;
+                h = head.load(std::memory_order_relaxed);
+            } else if (head.compare_exchange_weak(h, h + 1,
+                                                  std::memory_order_relaxed)) {
+                std::optional<T> item = std::move(slot.item);
+                slot.item.reset();
+                slot.sequence.store(h + mask + 1, std::memory_order_release);
+                return item;
+            }
+        }
+    }
+
+    /**
+     * @class 	StealingBuffer
+     * @brief 	A single producer, multiple consumer buffer with a
+     * 			lock-free lane per consumer
+     * @details Each spmc::Receiver copied from the Sender, or from
+     * 			another Receiver, is attached to its own bounded lane.
+     * 			The Sender deals items round-robin into the lanes of
+     * 			live Receivers, skipping full ones. A Receiver pops its
+     * 			own lane first and steals from the others when it is
+     * 			empty, so a slow Receiver does not strand items. Idle
+     * 			Receivers sleep on a shared Signal, and the Sender
+     * 			sleeps on another while every lane is full. Lanes of
+     * 			destructed Receivers are stolen from until empty, then
+     * 			removed. Items are not ordered across lanes.
+     * @tparam 	T The type of item stored in the buffer
+     * @extends Buffer
+     * @note 	Only one thread may send at a time. A listener on a
+     * 			Receiver is notified when any lane fills, since that
+     * 			Receiver may steal the item.
+     */
+    template <typename T> class StealingBuffer final : public Buffer<T> {
+            class Port;
+            using Lanes = std::vector<std::shared_ptr<SharedLane<T>>>;
+
+            /// State shared by the buffer and its ports
+            struct Hub {
+                    std::size_t n;
+                    Placement placement;
+
+                    /// Every attached port, guarded by mutex; cleared
+                    /// when the buffer is destructed
+                    std::vector<std::shared_ptr<Port>> ports;
+                    std::mutex mutex;
+                    std::atomic<std::uint64_t> generation{0};
+
+                    Signal items, room;
+                    std::atomic<bool> closed{false};
+
+                    /// Raised when any port's Readiness is armed
+                    std::atomic<bool> armed{false};
+
+                    Hub(std::size_t n, Placement placement)
+                        : n(n), placement(placement) {}
+
+                    /// Registers a new port
+                    std::shared_ptr<Port> add(std::shared_ptr<Hub> self);
+
+                    /// Notifies the listeners of armed ports
+                    void fill();
+
+                    /// Copies the lanes if they changed since seen
+                    void refresh(Lanes& lanes, std::uint64_t& seen);
+            };
+
+            /// The buffer a Receiver pops from
+            class Port final : public Buffer<T> {
+                    friend class StealingBuffer<T>;
+
+                    std::shared_ptr<Hub> hub;
+                    std::shared_ptr<SharedLane<T>> lane;
+                    Readiness readiness;
+
+                    /// The consumer's copy of every lane
+                    Lanes lanes;
+                    std::uint64_t seen = ~std::uint64_t(0);
+                    std::size_t victim = 0;
+
+                    bool empty() const override { return lane->empty(); }
+
+                    /// Steals an item from another lane
+                    std::optional<T> steal();
+
+                    /// Checks whether any lane holds items, or the
+                    /// buffer is gone
+                    bool ready();
+
+                public:
+                    explicit Port(std::shared_ptr<Hub> hub)
+                        : hub(std::move(hub)),
+                          lane(std::make_shared<SharedLane<T>>(
+                              this->hub->n, this->hub->placement)),
+                          readiness(&this->hub->armed) {}
+
+                    std::shared_ptr<Buffer<T>>
+                    attach(std::shared_ptr<Buffer<T>>) override {
+                        return hub->add(hub);
+                    }
+
+                    void detach() override {
+                        lane->closed.store(true, std::memory_order_release);
+                    }
+
+                    using Buffer<T>::push;
+
+                    void push(T&&) override {
+                        throw std::logic_error("lanes are pushed by "
+                                               "their buffer");
+                    }
+
+                    T pop() override;
+
+                    std::optional<T> try_pop() override;
+
+                    void listen(std::shared_ptr<Listener> listener) override {
+                        readiness.listen(std::move(listener),
+                                         [this] { return ready(); });
+                    }
+            };
+
+            std::shared_ptr<Hub> hub;
+
+            /// The port used by pop() on the buffer itself
+            std::shared_ptr<Port> own;
+
+            /// The producer's copy of every lane
+            Lanes lanes;
+            std::uint64_t seen = ~std::uint64_t(0);
+            std::size_t next = 0;
+
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes drained lanes of destructed Receivers
+            void sweep();
+
+        public:
+            /**
+             * @brief 	Constructs a stealing buffer
+             * @param 	n The capacity of each lane
+             * @param 	placement Where each lane's slots should live
+             */
+            explicit StealingBuffer(std::size_t n = 1024,
+                                    Placement placement = {})
+                : hub(std::make_shared<Hub>(n, placement)),
+                  own(hub->add(hub)) {}
+
+            StealingBuffer(const StealingBuffer<T>&) = delete;
+            StealingBuffer(StealingBuffer<T>&&) = delete;
+
+            /**
+             * @brief 	Destructs a StealingBuffer, expiring its Receivers
+             */
+            ~StealingBuffer();
+
+            /**
+             * @brief 	Attaches a new lane for a Receiver
+             * @return 	The lane
+             */
+            std::shared_ptr<Buffer<T>>
+            attach(std::shared_ptr<Buffer<T>>) override {
+                return hub->add(hub);
+            }
+
+            using Buffer<T>::push;
+
+            /**
+             * @brief 	Moves and pushes an item into the buffer
+             * @param 	item The item being pushed into the buffer
+             * @note 	Blocks while every lane is full
+             */
+            void push(T&& item) override;
+
+            /**
+             * @brief 	Pops an item from the buffer
+             * @return 	The item being popped from the buffer
+             * @note 	Blocks on an empty buffer
+             */
+            T pop() override { return own->pop(); }
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override { return own->try_pop(); }
+
+            /**
+             * @brief 	Attaches a readiness listener to the buffer
+             * @param 	listener The listener, or nullptr to detach
+             */
+            void listen(std::shared_ptr<Listener> listener) override {
+                own->listen(std::move(listener));
+            }
+    };
+
+    template <typename T>
+    std::shared_ptr<typename StealingBuffer<T>::Port>
+    StealingBuffer<T>::Hub::add(std::shared_ptr<Hub> self) {
+        auto port = std::make_shared<Port>(std::move(self));
+        {
+            auto lock = std::unique_lock(mutex);
+            ports.push_back(port);
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        room.notify();
+        return port;
+    }
+
+    template <typename T>
+    void StealingBuffer<T>::Hub::refresh(Lanes& lanes, std::uint64_t& seen) {
+        if (generation.load(std::memory_order_acquire) == seen)
+            return;
+        auto lock = std::unique_lock(mutex);
+        lanes.clear();
+        for (auto& port : ports) {
+            lanes.push_back(port->lane);
+        }
+        seen = generation.load(std::memory_order_relaxed);
+    }
+
+    template <typename T> void StealingBuffer<T>::Hub::fill() {
+        if (!armed.load(std::memory_order_relaxed) ||
+            !armed.exchange(false, std::memory_order_seq_cst))
+            return;
+        auto lock = std::unique_lock(mutex);
+        for (auto& port : ports) {
+            port->readiness.fill();
+        }
+    }
+
+    template <typename T> std::optional<T> StealingBuffer<T>::Port::steal() {
+        hub->refresh(lanes, seen);
+        for (std::size_t i = 0; i < lanes.size(); i++) {
+            auto index = (victim + i) % lanes.size();
+            if (lanes[index] == lane)
+                continue;
+            if (auto item = lanes[index]->try_pop()) {
+                victim = index;
+                return item;
+            }
+        }
+        return std::nullopt;
+    }
+
+    template <typename T>
+    std::optional<T> StealingBuffer<T>::Port::try_pop() {
+        auto item = lane->try_pop();
+        if (!item)
+            item = steal();
+        if (item)
+            hub->room.notify();
+        else
+            readiness.drain([this] { return ready(); });
+        return item;
+    }
+
+    template <typename T> bool StealingBuffer<T>::Port::ready() {
+        if (hub->closed.load(std::memory_order_acquire))
+            return true;
+        hub->refresh(lanes, seen);
+        return std::any_of(lanes.begin(), lanes.end(),
+                           [](auto& lane) { return !lane->empty(); });
+    }
+
+    template <typename T> T StealingBuffer<T>::Port::pop() {
+        while (true) {
+            if (auto item = try_pop())
+                return std::move(*item);
+            if (hub->closed.load(std::memory_order_acquire))
+                throw std::runtime_error("sender is expired");
+
+            hub->items.sleep([this] { return ready(); });
+        }
+    }
+
+    template <typename T> StealingBuffer<T>::~StealingBuffer() {
+        {
+            auto lock = std::unique_lock(hub->mutex);
+            hub->closed.store(true, std::memory_order_release);
+            hub->ports.clear();
+        }
+        hub->items.notify();
+    }
+
+    template <typename T> bool StealingBuffer<T>::empty() const {
+        auto lock = std::unique_lock(hub->mutex);
+        return std::all_of(hub->ports.begin(), hub->ports.end(),
+                           [](auto& port) { return port->lane->empty(); });
+    }
+
+    template <typename T> void StealingBuffer<T>::sweep() {
+        auto lock = std::unique_lock(hub->mutex);
+        std::erase_if(hub->ports, [](auto& port) {
+            return port->lane->closed.load(std::memory_order_acquire) &&
+                   port->lane->empty();
+        });
+        hub->generation.fetch_add(1, std::memory_order_release);
+    }
+
+    template <typename T> void StealingBuffer<T>::push(T&& item) {
+        while (true) {
+            hub->refresh(lanes, seen);
+
+            // Deal to live Receivers, or to the buffer's own lane if
+            // there are none
+            bool drained = false, live = false;
+            for (std::size_t i = 0; i < lanes.size(); i++) {
+                auto index = (next + i) % lanes.size();
+                auto& lane = lanes[index];
+                if (lane == own->lane)
+                    continue;
+                if (lane->closed.load(std::memory_order_acquire)) {
+                    drained |= lane->empty();
+                    continue;
+                }
+                live = true;
+                if (lane->try_push(item)) {
+                    next = index + 1;
+                    hub->items.notify();
+                    hub->fill();
+                    return;
+                }
+            }
+            if (drained)
+                sweep();
+            if (!live && own->lane->try_push(item)) {
+                hub->items.notify();
+                hub->fill();
+                return;
+            }
+
+            // Every live lane is full; wait for a pop or a new Receiver
+            hub->room.sleep([this] {
+                if (hub->generation.load(std::memory_order_acquire) != seen)
+                    return true;
+                return std::any_of(lanes.begin(), lanes.end(), [&](auto& lane) {
+                    return lane != own->lane && !lane->full() &&
+                           !lane->closed.load(std::memory_order_acquire);
+                });
+            });
+        }
+    }
+} // namespace piper::internal
+
+namespace piper::mpsc {
+    struct Topology;
+} // namespace piper::mpsc
+
+namespace piper::spmc {
+    struct Topology;
+} // namespace piper::spmc
+
+namespace piper::flavor {
+    /**
+     * @struct 	Sharded
+     * @brief 	Selects a lock-free lane per Sender, for MPSC channels
+     */
+    struct Sharded {
+            template <typename T>
+            using Buffer = internal::ShardedBuffer<T>;
+
+            /// The only topology the buffer works with
+            using Topology = mpsc::Topology;
+    };
+
+    /**
+     * @struct 	Stealing
+     * @brief 	Selects a lock-free lane per Receiver with work
+     * 			stealing, for SPMC channels
+     */
+    struct Stealing {
+            template <typename T>
+            using Buffer = internal::StealingBuffer<T>;
+
+            /// The only topology the buffer works with
+            using Topology = spmc::Topology;
+    };
+} // namespace piper::flavor
@@ -0,0 +1,376 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @internal
+ * @file		spill.hpp
+ * @brief		Unbounded buffer that spills to memory-mapped files
+ * @author		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "piper/codec.hpp"
+#include "piper/internal/buffer.hpp"
+
+namespace piper::internal {
+    /**
+     * @class 	SpillSegment
+     * @brief 	A memory-mapped file of length-prefixed records
+     * @details The file is unlinked as soon as it is created, so it
+     * 			is reclaimed when the segment is destroyed, even if
+     * 			the process crashes.
+     */
+    class SpillSegment {
+            int fd = -1;
+            std::byte* base = nullptr;
+            std::size_t size = 0;
+
+            /// Offset of the next record to read
+            std::size_t head = 0;
+
+            /// Offset of the next record to write
+            std::size_t tail = 0;
+
+        public:
+            /**
+             * @brief 	Creates a segment file
+             * @param 	directory The directory holding the file
+             * @param 	size The size of the file
+             * @throws 	std::system_error Thrown if the file cannot be
+             * 			created, reserved or mapped, e.g. with ENOSPC on
+             * 			a full disk
+             */
+            SpillSegment(const std::string& directory, std::size_t size);
+
+            SpillSegment(SpillSegment&& segment);
+            SpillSegment(const SpillSegment&) = delete;
+
+            ~SpillSegment();
+
+            /**
+             * @brief 	Appends a record to the segment
+             * @param 	record The record being appended
+             * @return 	Whether the record fit in the segment
+             */
+            bool append(std::span<const std::byte> record);
+
+            /**
+             * @brief 	Reads the next record, without consuming it
+             * @return 	The record, valid until the segment is destroyed
+             * @warning Calling this method on an exhausted segment is
+             * 			undefined behavior
+             */
+            std::span<const std::byte> front() const;
+
+            /**
+             * @brief 	Consumes the next record
+             * @warning Calling this method on an exhausted segment is
+             * 			undefined behavior
+             */
+            void pop_front();
+
+            /**
+             * @brief 	Checks whether every record has been read
+             * @return 	Whether the segment is exhausted
+             */
+            bool exhausted() const { return head == tail; }
+    };
+
+    inline SpillSegment::SpillSegment(const std::string& directory,
+                                      std::size_t size)
+        : size(size) {
+        auto path = directory + "/piper-XXXXXX";
+        fd = mkstemp(path.data());
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "mkstemp");
+        unlink(path.c_str());
+
+        // Reserve the blocks now: writing a sparse file through the
+        // mapping would raise SIGBUS on a full disk
+        if (int error = posix_fallocate(fd, 0, static_cast<off_t>(size))) {
+            close(fd);
+            throw std::system_error(error, std::generic_category(),
+                                    "posix_fallocate");
+        }
+
+        auto address =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            auto error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        base = static_cast<std::byte*>(address);
+    }
+
+    inline SpillSegment::SpillSegment(SpillSegment&& segment)
+        : fd(segment.fd), base(segment.base), size(segment.size),
+          head(segment.head), tail(segment.tail) {
+        segment.fd = -1;
+        segment.base = nullptr;
+    }
+
+    inline SpillSegment::~SpillSegment() {
+        if (base)
+            munmap(base, size);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    inline bool SpillSegment::append(std::span<const std::byte> record) {
+        auto length = static_cast<std::uint32_t>(record.size());
+        if (tail + sizeof(length) + record.size() > size)
+            return false;
+
+        std::memcpy(base + tail, &length, sizeof(length));
+        std::memcpy(base + tail + sizeof(length), record.data(),
+                    record.size());
+        tail += sizeof(length) + record.size();
+        return true;
+    }
+
+    inline std::span<const std::byte> SpillSegment::front() const {
+        std::uint32_t length;
+        std::memcpy(&length, base + head, sizeof(length));
+        return std::span<const std::byte>(base + head + sizeof(length),
+                                          length);
+    }
+
+    inline void SpillSegment::pop_front() {
+        std::uint32_t length;
+        std::memcpy(&length, base + head, sizeof(length));
+        head += sizeof(length) + length;
+    }
+
+    /**
+     * @class 	SpillBuffer
+     * @brief 	An asynchronous, unbounded buffer with a memory budget
+     * @details Up to budget items are kept in memory, whatever their
+     * 			size, so the budget bounds memory only as far as the
+     * 			items' sizes are bounded. Beyond that, items are
+     * 			serialized into memory-mapped segment files, and every
+     * 			later item follows them to disk until the receiver has
+     * 			caught up, so items are always popped in FIFO order.
+     * 			Exhausted segments are deleted.
+     * @tparam 	T The type of item stored in the buffer
+     * @tparam 	Codec The serializer for spilled items
+     * @extends Buffer
+     */
+    template <typename T, typename Codec = piper::Codec<T>>
+    class SpillBuffer final : public Buffer<T> {
+            std::string directory;
+            std::size_t budget;
+            std::size_t segment;
+
+            /// Items held in memory, all older than spilled items
+            std::deque<T> queue;
+
+            /// Segments holding spilled items, oldest first
+            std::deque<SpillSegment> segments;
+
+            /// The number of items held in segments
+            std::size_t count = 0;
+
+            /// Scratch space for serializing items
+            std::vector<std::byte> scratch;
+
+            std::condition_variable available;
+
+            /// Checks whether the buffer holds no items
+            bool empty() const override;
+
+            /// Removes the next item, with the buffer lock held
+            T take();
+
+        public:
+            /**
+             * @brief 	Constructs a spilling buffer
+             * @param 	directory The directory for segment files
+             * @param 	budget The number of items, not bytes, kept in
+             * 			memory
+             * @param 	segment The size of each segment file in bytes
+             */
+            SpillBuffer(std::string directory, std::size_t budget,
+                        std::size_t segment = std::size_t(1) << 24)
+                : Buffer<T>(), directory(std::move(directory)), budget(budget),
+                  segment(segment) {}
+
+            SpillBuffer(const SpillBuffer<T, Codec>&) = delete;
+            SpillBuffer(SpillBuffer<T, Codec>&&) = delete;
+
+            using Buffer<T>::push;
+
+            /**
+             * @brief 	Moves and pushes an item into the buffer
+             * @param 	item The item being pushed into the buffer
+             * @throws 	std::system_error Thrown if a segment file cannot
+             * 			be created
+             * @note 	This implementation should not block
+             */
+            void push(T&& item) override;
+
+            /**
+             * @brief 	Pops an item from the buffer
+             * @return 	The item being popped from the buffer
+             * @note 	Blocks on an empty buffer
+             */
+            T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item being popped from the buffer, or
+             * 			std::nullopt if the buffer is empty
+             * @note 	This implementation does not block
+             */
+            std::optional<T> try_pop() override;
+
+            /**
+             * @brief 	Gets the number of items spilled to disk
+             * @return 	The number of items held in segment files
+             */
+            std::size_t spilled();
+    };
+
+    template <typename T, typename Codec>
+    bool SpillBuffer<T, Codec>::empty() const {
+        return this->queue.empty() && this->count == 0;
+    }
+
+    template <typename T, typename Codec> T SpillBuffer<T, Codec>::take() {
+        T item;
+        if (!this->queue.empty()) {
+            item = std::move(this->queue.front());
+            this->queue.pop_front();
+        } else {
+            // Page the oldest spilled item back in, consuming it only
+            // once it decodes
+            auto& oldest = this->segments.front();
+            item = Codec::decode(oldest.front());
+            oldest.pop_front();
+            this->count--;
+            if (oldest.exhausted())
+                this->segments.pop_front();
+        }
+
+        if (empty())
+            this->drained();
+        return item;
+    }
+
+    template <typename T, typename Codec>
+    void SpillBuffer<T, Codec>::push(T&& item) {
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+            auto was_empty = empty();
+
+            if (this->count == 0 && this->queue.size() < this->budget) {
+                // Push item to queue
+                this->queue.push_back(std::forward<T>(item));
+            } else {
+                // Spill item to the newest segment
+                this->scratch.clear();
+                Codec::encode(item, this->scratch);
+                if (this->segments.empty() ||
+                    !this->segments.back().append(this->scratch)) {
+                    auto size = std::max(this->segment,
+                                         this->scratch.size() +
+                                             sizeof(std::uint32_t));
+                    this->segments.emplace_back(this->directory, size);
+                    this->segments.back().append(this->scratch);
+                }
+                this->count++;
+            }
+
+            if (was_empty)
+                this->filled();
+        }
+
+        this->available.notify_one();
+    }
+
+    template <typename T, typename Codec> T SpillBuffer<T, Codec>::pop() {
+        T item;
+        {
+            // Acquire lock
+            auto lock = std::unique_lock(this->mutex);
+
+            // Block receiver if buffer is empty
+            this->available.wait(lock, [this] { return !empty(); });
+
+            // Pop item from memory or disk
+            item = take();
+        }
+        return item;
+    }
+
+    template <typename T, typename Codec>
+    std::optional<T> SpillBuffer<T, Codec>::try_pop() {
+        // Acquire lock
+        auto lock = std::unique_lock(this->mutex);
+
+        if (empty())
+            return std::nullopt;
+        return take();
+    }
+
+    template <typename T, typename Codec>
+    std::size_t SpillBuffer<T, Codec>::spilled() {
+        auto lock = std::unique_lock(this->mutex);
+        return this->count;
+    }
+} // namespace piper::internal
+
+namespace piper::flavor {
+    /**
+     * @struct 	Spill
+     * @brief 	Selects an unbounded buffer that spills to disk
+     * @tparam 	Codec The serializer for spilled items, by default
+     * 			piper::Codec
+     */
+    template <template <typename> typename Codec = piper::Codec> struct Spill {
+            template <typename T>
+            using Buffer = internal::SpillBuffer<T, Codec<T>>;
+    };
+} // namespace piper::flavor
@@ -0,0 +1,486 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		ipc.hpp
+ * @brief 		Shared memory, interprocess channel
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "piper/numa.hpp"
+#include "piper/piper.hpp"
+
+namespace piper::internal {
+    /**
+     * @struct 	SharedControl
+     * @brief 	Control words at the start of a shared ring segment
+     * @details Each counter shares a cache line only with the waiting
+     * 			flag written by the same side of the channel.
+     */
+    struct SharedControl {
+            static constexpr std::uint32_t signature = 0x70697072;
+
+            /// Items popped by the receiver
+            alignas(64) std::atomic<std::uint32_t> head;
+            /// Set while the receiver sleeps on tail
+            std::atomic<std::uint32_t> receiving;
+
+            /// Items pushed by the sender
+            alignas(64) std::atomic<std::uint32_t> tail;
+            /// Set while the sender sleeps on head
+            std::atomic<std::uint32_t> sending;
+
+            alignas(64) std::uint32_t magic;
+
+            /// A power of two, so slot indices stay contiguous when the
+            /// counters wrap around
+            std::uint32_t capacity;
+            std::uint64_t size;
+    };
+
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free,
+                  "shared control words must be lock-free");
+
+    /// Sleeps while word holds expected, across processes
+    inline void futex_wait(std::atomic<std::uint32_t>& word,
+                           std::uint32_t expected) {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAIT, expected, nullptr, nullptr, 0);
+    }
+
+    /// Wakes every process sleeping on word
+    inline void futex_wake(std::atomic<std::uint32_t>& word) {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    /**
+     * @class 	SharedRing
+     * @brief 	A mapping of a shared ring segment
+     * @tparam 	T The type of item stored in the ring
+     */
+    template <typename T> class SharedRing {
+            SharedControl* control;
+            T* slots;
+            std::size_t length;
+
+        public:
+            /**
+             * @brief 	Creates a ring segment in an anonymous memory file
+             * @param 	n The size of the ring, rounded up to a power of
+             * 			two
+             * @param 	placement Where the segment's pages should live;
+             * 			huge pages are honored, transparent huge pages
+             * 			are not, since they are advised per mapping
+             * @return 	The file descriptor of the segment
+             * @throws 	std::system_error Thrown if the segment cannot
+             * 			be created
+             */
+            static int create(std::size_t n, Placement placement = {});
+
+            /**
+             * @brief 	Maps a ring segment
+             * @param 	fd The file descriptor of the segment, which is
+             * 			not retained
+             * @throws 	std::system_error Thrown if the segment cannot
+             * 			be mapped
+             * @throws 	std::runtime_error Thrown if the segment was not
+             * 			created for items of type T
+             */
+            explicit SharedRing(int fd);
+
+            SharedRing(SharedRing<T>&& ring);
+            SharedRing(const SharedRing<T>&) = delete;
+
+            ~SharedRing();
+
+            /**
+             * @brief 	Pushes an item into the ring
+             * @param 	item The item being pushed into the ring
+             * @note 	Blocks on a full ring
+             */
+            void push(const T& item);
+
+            /**
+             * @brief 	Pops an item from the ring
+             * @return 	The item being popped from the ring
+             * @note 	Blocks on an empty ring
+             */
+            T pop();
+
+            /**
+             * @brief 	Pops an item from the ring, if one is available
+             * @return 	The item being popped from the ring, or
+             * 			std::nullopt if the ring is empty
+             */
+            std::optional<T> try_pop();
+    };
+
+    template <typename T>
+    int SharedRing<T>::create(std::size_t n, Placement placement) {
+        if (n == 0 || n > (std::size_t(1) << 31))
+            throw std::invalid_argument("invalid ring size");
+        n = std::bit_ceil(n);
+
+        auto length = sizeof(SharedControl) + n * sizeof(T);
+        int fd = -1;
+        void* address = MAP_FAILED;
+
+        // Huge pages need a reserved pool, so fall back without one
+        if (placement.pages == Placement::Pages::huge) {
+            auto huge = Placement::huge_page_size();
+            auto size = (length + huge - 1) / huge * huge;
+            fd = memfd_create("piper", MFD_CLOEXEC | MFD_HUGETLB);
+            if (fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) == 0)
+                address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                               MAP_SHARED, fd, 0);
+            if (address != MAP_FAILED) {
+                length = size;
+            } else if (fd >= 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+
+        if (fd < 0) {
+            fd = memfd_create("piper", MFD_CLOEXEC);
+            if (fd < 0)
+                throw std::system_error(errno, std::generic_category(),
+                                        "memfd_create");
+
+            if (ftruncate(fd, static_cast<off_t>(length)) < 0) {
+                auto error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(),
+                                        "ftruncate");
+            }
+
+            address = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED) {
+                auto error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(),
+                                        "mmap");
+            }
+        }
+
+        // The policy is kept by the file, so it covers every mapping
+        placement.apply(address, length);
+
+        // The file is zero-filled, so only the header needs writing
+        auto control = static_cast<SharedControl*>(address);
+        control->magic = SharedControl::signature;
+        control->capacity = static_cast<std::uint32_t>(n);
+        control->size = sizeof(T);
+        munmap(address, length);
+
+        return fd;
+    }
+
+    template <typename T> SharedRing<T>::SharedRing(int fd) {
+        struct stat info;
+        if (fstat(fd, &info) < 0)
+            throw std::system_error(errno, std::generic_category(), "fstat");
+        length = static_cast<std::size_t>(info.st_size);
+        if (length < sizeof(SharedControl))
+            throw std::runtime_error("segment is too small");
+
+        auto address =
+            mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category(), "mmap");
+
+        control = static_cast<SharedControl*>(address);
+        slots = reinterpret_cast<T*>(control + 1);
+        if (control->magic != SharedControl::signature ||
+            control->size != sizeof(T) ||
+            !std::has_single_bit(control->capacity) ||
+            length < sizeof(SharedControl) + control->capacity * sizeof(T)) {
+            munmap(address, length);
+            throw std::runtime_error("segment does not match item type");
+        }
+    }
+
+    template <typename T>
+    SharedRing<T>::SharedRing(SharedRing<T>&& ring)
+        : control(ring.control), slots(ring.slots), length(ring.length) {
+        ring.control = nullptr;
+    }
+
+    template <typename T> SharedRing<T>::~SharedRing() {
+        if (control)
+            munmap(control, length);
+    }
+
+    template <typename T> void SharedRing<T>::push(const T& item) {
+        auto tail = control->tail.load(std::memory_order_relaxed);
+        for (;;) {
+            auto head = control->head.load(std::memory_order_acquire);
+            if (tail - head < control->capacity)
+                break;
+
+            // Sleep until the receiver moves head
+            control->sending.store(1);
+            if (control->head.load() == head)
+                futex_wait(control->head, head);
+            control->sending.store(0, std::memory_order_relaxed);
+        }
+
+        slots[tail & (control->capacity - 1)] = item;
+        control->tail.store(tail + 1);
+
+        // Wake the receiver only if it is asleep
+        if (control->receiving.load())
+            futex_wake(control->tail);
+    }
+
+    template <typename T> T SharedRing<T>::pop() {
+        auto head = control->head.load(std::memory_order_relaxed);
+        for (;;) {
+            auto tail = control->tail.load(std::memory_order_acquire);
+            if (tail != head)
+                break;
+
+            // Sleep until the sender moves tail
+            control->receiving.store(1);
+            if (control->tail.load() == tail)
+                futex_wait(control->tail, tail);
+            control->receiving.store(0, std::memory_order_relaxed);
+        }
+
+        T item = slots[head & (control->capacity - 1)];
+        control->head.store(head + 1);
+
+        // Wake the sender only if it is asleep
+        if (control->sending.load())
+            futex_wake(control->head);
+
+        return item;
+    }
+
+    template <typename T> std::optional<T> SharedRing<T>::try_pop() {
+        auto head = control->head.load(std::memory_order_relaxed);
+        if (control->tail.load(std::memory_order_acquire) == head)
+            return std::nullopt;
+
+        T item = slots[head & (control->capacity - 1)];
+        control->head.store(head + 1);
+
+        // Wake the sender only if it is asleep
+        if (control->sending.load())
+            futex_wake(control->head);
+
+        return item;
+    }
+} // namespace piper::internal
+
+/**
+ * @namespace 	piper::ipc
+ * @brief 		Concrete Channel, Sender, and Receiver implementations
+ * 				for single producer, single consumer channels
+ * 				shared between processes
+ */
+namespace piper::ipc {
+    /**
+     * @class 		Receiver
+     * @brief 		IPC channel receiver
+     * @tparam 		T The type of item being received over the channel
+     * @implements	piper::Receiver
+     */
+    template <typename T> class Receiver : public piper::Receiver<T> {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "IPC channel items must be trivially copyable");
+
+            piper::internal::SharedRing<T> ring;
+
+        public:
+            /**
+             * @brief 	Constructs a Receiver over a shared segment
+             * @param 	fd The file descriptor of a Channel segment
+             */
+            explicit Receiver(int fd) : ring(fd) {}
+
+            /**
+             * @brief 	Moves a Receiver
+             * @param 	rx The Receiver to move
+             */
+            Receiver(Receiver<T>&& rx) = default;
+
+            Receiver(const Receiver<T>&) = delete;
+
+            /**
+             * @brief 	Receives an item from the channel
+             * @return 	The item received from the channel
+             * @note 	Blocks on an empty buffer
+             */
+            T recv() override { return ring.pop(); }
+
+            /**
+             * @brief 	Receives an item from the channel, if one is
+             * 			available
+             * @return 	The item received from the channel, or
+             * 			std::nullopt if the buffer is empty
+             */
+            std::optional<T> try_recv() override { return ring.try_pop(); }
+    };
+
+    /**
+     * @class 		Sender
+     * @brief 		IPC channel sender
+     * @tparam 		T The type of item being sent over the channel
+     * @implements	piper::Sender
+     */
+    template <typename T> class Sender : public piper::Sender<T> {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "IPC channel items must be trivially copyable");
+
+            piper::internal::SharedRing<T> ring;
+
+        public:
+            /**
+             * @brief 	Constructs a Sender over a shared segment
+             * @param 	fd The file descriptor of a Channel segment
+             */
+            explicit Sender(int fd) : ring(fd) {}
+
+            /**
+             * @brief 	Moves a Sender
+             * @param 	tx The Sender to move
+             */
+            Sender(Sender<T>&& tx) = default;
+
+            Sender(const Sender<T>&) = delete;
+
+            /**
+             * @brief 	Copies and sends an item over the channel
+             * @param 	item The item being sent over the channel
+             * @note  	Blocks on a full buffer
+             */
+            void send(const T& item) override { ring.push(item); }
+
+            /**
+             * @brief 	Moves and sends an item over the channel
+             * @param 	item The item being sent over the channel
+             * @note  	Blocks on a full buffer
+             */
+            void send(T&& item) override { ring.push(item); }
+    };
+
+    /**
+     * @class 		Channel
+     * @brief 		A single producer, single consumer channel whose
+     * 				buffer lives in shared memory
+     * @details 	The Channel owns an anonymous memory file holding
+     * 				the ring. Other processes attach a Sender or
+     * 				Receiver to its file descriptor, inherited
+     * 				across fork() or passed over a Unix domain
+     * 				socket.
+     * @tparam 		T The type of item being exchanged over the
+     * 				channel, which must be trivially copyable
+     * @implements 	piper::Channel
+     * @warning 	At most one Sender and one Receiver may use the
+     * 				channel at a time.
+     */
+    template <typename T> class Channel : public piper::Channel<T> {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "IPC channel items must be trivially copyable");
+
+            int descriptor;
+            piper::internal::SharedRing<T> ring;
+
+        public:
+            /**
+             * @brief 	Constructs a Channel
+             * @param 	n The size of the buffer, at least 1, rounded up
+             * 			to a power of two
+             * @param 	placement Where the shared segment should live
+             */
+            explicit Channel(std::size_t n, Placement placement = {})
+                : descriptor(
+                      piper::internal::SharedRing<T>::create(n, placement)),
+                  ring(descriptor) {}
+
+            Channel(const Channel<T>&) = delete;
+
+            ~Channel() { close(descriptor); }
+
+            /**
+             * @brief 	Gets the file descriptor of the shared segment
+             * @return 	The file descriptor, owned by the Channel
+             */
+            int fd() const { return descriptor; }
+
+            /**
+             * @brief 	Receives an item from the channel
+             * @return 	The item received from the channel
+             * @note 	Blocks on an empty buffer
+             */
+            T recv() override { return ring.pop(); }
+
+            /**
+             * @brief 	Receives an item from the channel, if one is
+             * 			available
+             * @return 	The item received from the channel, or
+             * 			std::nullopt if the buffer is empty
+             */
+            std::optional<T> try_recv() override { return ring.try_pop(); }
+
+            /**
+             * @brief 	Copies and sends an item over the channel
+             * @param 	item The item being sent over the channel
+             * @note  	Blocks on a full buffer
+             */
+            void send(const T& item) override { ring.push(item); }
+
+            /**
+             * @brief 	Moves and sends an item over the channel
+             * @param 	item The item being sent over the channel
+             * @note  	Blocks on a full buffer
+             */
+            void send(T&& item) override { ring.push(item); }
+    };
+} // namespace piper::ipc
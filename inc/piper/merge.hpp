@@ -0,0 +1,274 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		merge.hpp
+ * @brief 		Weighted fair merging of receivers
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "piper/internal/buffer.hpp"
+#include "piper/piper.hpp"
+
+namespace piper {
+    /**
+     * @struct 	Weighted
+     * @brief 	An input to a merge, with its share of the output
+     */
+    template <typename Rx> struct Weighted {
+            Rx rx;
+            std::size_t weight;
+    };
+
+    /**
+     * @brief 	Gives an input to a merge a weight
+     * @param 	rx The input
+     * @param 	weight The number of items taken from it per round, at
+     * 			least 1
+     */
+    template <typename Rx> Weighted<Rx> weighted(Rx rx, std::size_t weight) {
+        return {std::move(rx), std::max<std::size_t>(weight, 1)};
+    }
+} // namespace piper
+
+namespace piper::internal {
+    /// The type of a merge input, with or without a weight
+    template <typename Rx> struct Unweighted {
+            using type = Rx;
+    };
+    template <typename Rx> struct Unweighted<Weighted<Rx>> {
+            using type = Rx;
+    };
+} // namespace piper::internal
+
+namespace piper {
+    /**
+     * @class 	Merge
+     * @brief 	A Receiver that takes items fairly from several inputs
+     * @details Inputs are served by deficit round robin: each round,
+     * 			an input may hand out as many items as its weight, and
+     * 			one that runs dry forfeits the rest of its turn. A busy
+     * 			input therefore cannot starve the others, and each
+     * 			input's share of a saturated output follows its weight.
+     * 			The merge waits on every input at once through their
+     * 			readiness listeners, so it needs no thread per input.
+     * 			An expired input is skipped, and receiving throws once
+     * 			every input has expired.
+     * @tparam 	T The type of item received
+     * @note 	The merge replaces any listener on its inputs. It has a
+     * 			single consumer, such as a Stage.
+     */
+    template <typename T> class Merge final : public Receiver<T> {
+            /// Counts readiness notifications from the inputs
+            struct Signal {
+                    std::mutex mutex;
+                    std::condition_variable changed;
+                    std::uint64_t count = 0;
+                    std::shared_ptr<internal::Listener> listener;
+
+                    void notify() {
+                        std::shared_ptr<internal::Listener> outer;
+                        {
+                            auto lock = std::unique_lock(mutex);
+                            count++;
+                            outer = listener;
+                        }
+                        changed.notify_all();
+                        if (outer)
+                            outer->filled();
+                    }
+            };
+
+            /// Notifies on a filled or destroyed input buffer
+            struct Wake final : internal::Listener {
+                    std::shared_ptr<Signal> signal;
+                    explicit Wake(std::shared_ptr<Signal> signal)
+                        : signal(std::move(signal)) {}
+                    ~Wake() { signal->notify(); }
+                    void filled() override { signal->notify(); }
+                    void drained() override {}
+            };
+
+            struct Input {
+                    std::unique_ptr<Receiver<T>> rx;
+                    std::size_t weight;
+                    bool expired = false;
+            };
+
+            std::shared_ptr<Signal> signal = std::make_shared<Signal>();
+            std::vector<Input> inputs;
+            std::size_t expired = 0;
+
+            /// The input being served, and the items left in its turn
+            std::size_t current = 0;
+            std::size_t credit = 0;
+
+            template <typename Rx> void add(Weighted<Rx> input);
+            template <typename Rx> void add(Rx rx) {
+                add(Weighted<Rx>{std::move(rx), 1});
+            }
+
+        public:
+            /**
+             * @brief 	Constructs a Merge
+             * @param 	inputs The inputs, owned by the merge, each
+             * 			optionally wrapped by piper::weighted()
+             */
+            template <typename... Rx> explicit Merge(Rx... inputs) {
+                this->inputs.reserve(sizeof...(Rx));
+                (add(std::move(inputs)), ...);
+            }
+
+            Merge(Merge<T>&&) = default;
+            Merge(const Merge<T>&) = delete;
+
+            /**
+             * @brief 	Receives an item from the next input due one
+             * @throws 	std::runtime_error Thrown once every input has
+             * 			expired
+             * @note 	Blocks until any input holds an item
+             */
+            T recv() override;
+
+            /**
+             * @brief 	Receives an item from the next input due one, if
+             * 			any input holds an item
+             * @throws 	std::runtime_error Thrown once every input has
+             * 			expired
+             */
+            std::optional<T> try_recv() override;
+
+            /**
+             * @brief 	Attaches a readiness listener to the merge
+             * @param 	listener Notified whenever an input may have
+             * 			become ready, or has expired
+             */
+            void listen(std::shared_ptr<internal::Listener> listener);
+
+            /// Gets the number of inputs
+            std::size_t size() const { return inputs.size(); }
+    };
+
+    /**
+     * @brief 	Merges receivers of the same item type
+     * @param 	first, rest The inputs, each optionally wrapped by
+     * 			piper::weighted()
+     * @return 	The merge, which owns the inputs
+     */
+    template <typename First, typename... Rest>
+    auto merge(First first, Rest... rest) {
+        using Rx = typename internal::Unweighted<First>::type;
+        using T = std::remove_cvref_t<decltype(std::declval<Rx&>().recv())>;
+        return Merge<T>(std::move(first), std::move(rest)...);
+    }
+
+    template <typename T>
+    template <typename Rx>
+    void Merge<T>::add(Weighted<Rx> input) {
+        static_assert(std::is_base_of_v<Receiver<T>, Rx>,
+                      "merged inputs must receive the same item type");
+        auto rx = std::make_unique<Rx>(std::move(input.rx));
+        bool gone = false;
+        try {
+            rx->listen(std::make_shared<Wake>(signal));
+        } catch (const std::runtime_error&) {
+            gone = true;
+        }
+        inputs.push_back({std::move(rx), input.weight, gone});
+        expired += gone;
+    }
+
+    template <typename T> std::optional<T> Merge<T>::try_recv() {
+        for (std::size_t i = 0; i < inputs.size(); i++) {
+            auto& input = inputs[current];
+            if (!input.expired) {
+                if (credit == 0)
+                    credit = input.weight;
+                try {
+                    if (auto item = input.rx->try_recv()) {
+                        if (--credit == 0)
+                            current = (current + 1) % inputs.size();
+                        return item;
+                    }
+                } catch (const std::runtime_error&) {
+                    input.expired = true;
+                    expired++;
+                }
+            }
+
+            // An input that runs dry forfeits the rest of its turn
+            credit = 0;
+            current = (current + 1) % inputs.size();
+        }
+
+        if (expired == inputs.size())
+            throw std::runtime_error("sender is expired");
+        return std::nullopt;
+    }
+
+    template <typename T> T Merge<T>::recv() {
+        for (;;) {
+            std::uint64_t seen;
+            {
+                auto lock = std::unique_lock(signal->mutex);
+                seen = signal->count;
+            }
+            if (auto item = try_recv())
+                return std::move(*item);
+
+            auto lock = std::unique_lock(signal->mutex);
+            signal->changed.wait(lock,
+                                 [&] { return signal->count != seen; });
+        }
+    }
+
+    template <typename T>
+    void Merge<T>::listen(std::shared_ptr<internal::Listener> listener) {
+        {
+            auto lock = std::unique_lock(signal->mutex);
+            signal->listener = listener;
+        }
+
+        // An input may already hold items, which will not notify again
+        if (listener)
+            listener->filled();
+    }
+} // namespace piper
@@ -31,7 +31,10 @@
  * @date 		2022-04-18
  */
 
+#pragma once
+
 #include <stdexcept>
+#include <type_traits>
 
 #include "piper/internal/buffer.hpp"
 #include "piper/piper.hpp"
@@ -71,6 +74,14 @@ namespace piper::mpsc {
              */
             Receiver(std::size_t n);
 
+            /**
+             * @brief 	Constructs a Receiver over an existing buffer
+             * @param 	buffer The channel buffer, of any flavor
+             */
+            explicit Receiver(
+                std::shared_ptr<piper::internal::Buffer<T>> buffer)
+                : buffer(std::move(buffer)) {}
+
             /**
              * @brief 	Moves a Receiver
              * @param 	rx The Receiver to move
@@ -81,8 +92,7 @@ namespace piper::mpsc {
              * @brief 	Moves a Receiver from a Channel
              * @param 	ch The Channel from which Receiver is moved
              */
-            Receiver(Channel<T>&& ch)
-                : Receiver(std::forward<Receiver<T>>(ch.rx)) {}
+            Receiver(Channel<T>&& ch) : Receiver(std::move(ch.rx)) {}
 
             Receiver(const Receiver<T>&) = delete;
 
@@ -92,6 +102,29 @@ namespace piper::mpsc {
              * @note 	Blocks on an empty buffer
              */
             T recv() override;
+
+            /**
+             * @brief 	Receives an item from the channel, if one is
+             * 			available
+             * @return 	The item received from the channel, or
+             * 			std::nullopt if the buffer is empty
+             */
+            std::optional<T> try_recv() override { return buffer->try_pop(); }
+
+            /**
+             * @brief 	Attaches a readiness listener to the channel
+             * @param 	listener The listener, e.g. a piper::Notifier,
+             * 			or nullptr to detach
+             */
+            void listen(std::shared_ptr<piper::internal::Listener> listener) {
+                buffer->listen(std::move(listener));
+            }
+
+            /**
+             * @brief 	Gets the number of items dropped on overflow
+             * @return 	The number of items discarded by the buffer
+             */
+            std::size_t dropped() const { return buffer->dropped(); }
     };
 
     /**
@@ -113,8 +146,10 @@ namespace piper::mpsc {
             /**
              * @brief 	Copies a Sender from a Receiver
              * @param 	rx The Receiver from which Sender is copied
+             * @note 	Sharded buffers give each Sender its own lane
              */
-            Sender(const Receiver<T>& rx) : buffer(rx.buffer) {}
+            Sender(const Receiver<T>& rx)
+                : buffer(rx.buffer->attach(rx.buffer)) {}
 
             /**
              * @brief 	Copies a Sender from a Channel
@@ -130,9 +165,19 @@ namespace piper::mpsc {
 
             Sender() = delete;
 
+            /**
+             * @brief 	Destructs a Sender, releasing its lane if any
+             */
+            ~Sender() {
+                if (auto buffer = this->buffer.lock())
+                    buffer->detach();
+            }
+
             /**
              * @brief 	Copies and sends an item over the channel
              * @param 	item The item being sent over the channel
+             * @throws 	std::logic_error Thrown if T is not copy
+             * 			constructible
              * @note  	May block if using a synchronous buffer
              */
             void send(const T& item) noexcept(false) override;
@@ -143,6 +188,13 @@ namespace piper::mpsc {
              * @note  	May block if using a synchronous buffer
              */
             void send(T&& item) noexcept(false) override;
+
+            /**
+             * @brief 	Gets the number of items dropped on overflow
+             * @return 	The number of items discarded by the buffer,
+             * 			or zero if the buffer has expired
+             */
+            std::size_t dropped() const;
     };
 
     /**
@@ -155,22 +207,29 @@ namespace piper::mpsc {
             friend class Sender<T>;
             friend class Receiver<T>;
 
-            /// The Sender component
-            std::unique_ptr<Sender<T>> tx;
-
             /// The Receiver component
-            std::unique_ptr<Receiver<T>> rx;
+            Receiver<T> rx;
+
+            /// The Sender component
+            Sender<T> tx;
 
         public:
             /// Constructs an asynchronous Channel
-            Channel() : rx{new Receiver<T>()}, tx(*this->rx){};
+            Channel() : rx(), tx(this->rx) {}
 
             /**
              * @brief 	Constructs a synchronous Channel
              * @param	n The size of the buffer
              * @note	A size of 0 represents a rendezvous buffer
              */
-            Channel(std::size_t n) : rx{new Receiver<T>(n)}, tx(*this->rx) {}
+            Channel(std::size_t n) : rx(n), tx(this->rx) {}
+
+            /**
+             * @brief 	Constructs a Channel over an existing buffer
+             * @param 	buffer The channel buffer, of any flavor
+             */
+            explicit Channel(std::shared_ptr<piper::internal::Buffer<T>> buffer)
+                : rx(std::move(buffer)), tx(this->rx) {}
 
             /**
              * @brief	Moves a Channel
@@ -185,9 +244,19 @@ namespace piper::mpsc {
              */
             T recv() override;
 
+            /**
+             * @brief 	Receives an item from the channel, if one is
+             * 			available
+             * @return 	The item received from the channel, or
+             * 			std::nullopt if the buffer is empty
+             */
+            std::optional<T> try_recv() override { return rx.try_recv(); }
+
             /**
              * @brief 	Copies and sends an item over the channel
              * @param 	item The item being sent over the channel
+             * @throws 	std::logic_error Thrown if T is not copy
+             * 			constructible
              * @note  	May block if using a synchronous buffer
              */
             void send(const T& item) override;
@@ -200,17 +269,39 @@ namespace piper::mpsc {
             void send(T&& item) override;
     };
 
+    /**
+     * @struct 	Topology
+     * @brief 	Selects MPSC endpoints in piper::make_channel
+     */
+    struct Topology {
+            template <typename T> using Sender = mpsc::Sender<T>;
+            template <typename T> using Receiver = mpsc::Receiver<T>;
+
+            /**
+             * @brief 	Connects a Sender and Receiver over a buffer
+             * @param 	buffer The channel buffer, owned by the Receiver
+             * @return 	The connected Sender and Receiver
+             */
+            template <typename T>
+            static std::pair<Sender<T>, Receiver<T>>
+            connect(std::shared_ptr<piper::internal::Buffer<T>> buffer) {
+                Receiver<T> rx(std::move(buffer));
+                Sender<T> tx(rx);
+                return {std::move(tx), std::move(rx)};
+            }
+    };
+
     template <typename T> Receiver<T>::Receiver() {
         using namespace piper::internal;
-        buffer.reset(new AsyncBuffer<T>());
+        buffer = std::make_shared<AsyncBuffer<T>>();
     }
 
     template <typename T> Receiver<T>::Receiver(std::size_t n) {
         using namespace piper::internal;
         if (n > 0) {
-            buffer.reset(new SyncBuffer<T>(n));
+            buffer = std::make_shared<SyncBuffer<T>>(n);
         } else {
-            buffer.reset(new RendezvousBuffer<T>());
+            buffer = std::make_shared<RendezvousBuffer<T>>();
         }
     }
 
@@ -219,7 +310,11 @@ namespace piper::mpsc {
     template <typename T> void Sender<T>::send(const T& item) {
         if (buffer.expired())
             throw std::runtime_error("receiver is expired");
-        buffer.lock()->push(item);
+        if constexpr (std::is_copy_constructible_v<T>) {
+            buffer.lock()->push(item);
+        } else {
+            throw std::logic_error("item is not copy constructible");
+        }
     }
 
     template <typename T> void Sender<T>::send(T&& item) {
@@ -228,14 +323,19 @@ namespace piper::mpsc {
         buffer.lock()->push(std::forward<T>(item));
     }
 
-    template <typename T> T Channel<T>::recv() { return rx->recv(); }
+    template <typename T> std::size_t Sender<T>::dropped() const {
+        auto buffer = this->buffer.lock();
+        return buffer ? buffer->dropped() : 0;
+    }
+
+    template <typename T> T Channel<T>::recv() { return rx.recv(); }
 
     template <typename T> void Channel<T>::send(const T& item) {
-        tx->send(item);
+        tx.send(item);
     }
 
     template <typename T> void Channel<T>::send(T&& item) {
-        tx->send(std::forward<T>(item));
+        tx.send(std::forward<T>(item));
     }
 
 } // namespace piper::mpsc
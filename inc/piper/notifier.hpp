@@ -0,0 +1,116 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		notifier.hpp
+ * @brief 		Pollable readiness notification for channels
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <system_error>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "piper/internal/buffer.hpp"
+
+namespace piper {
+    /**
+     * @class 		Notifier
+     * @brief 		Exposes channel readiness as a pollable file descriptor
+     * @details 	Once attached to a channel with listen(), the
+     * 				file descriptor is readable exactly while the
+     * 				channel holds items, so it can be registered with
+     * 				epoll or poll alongside sockets. The eventfd is
+     * 				written only when the channel goes from empty to
+     * 				non-empty, and cleared when it is drained, so a
+     * 				burst of items costs a single wake-up.
+     * @implements 	piper::internal::Listener
+     * @note 		Drain the channel with Receiver::try_recv() once
+     * 				the descriptor becomes readable. A Notifier
+     * 				should be attached to at most one channel.
+     */
+    class Notifier final : public piper::internal::Listener {
+            int descriptor;
+
+        public:
+            /**
+             * @brief 	Constructs a Notifier
+             * @throws 	std::system_error Thrown if the eventfd cannot
+             * 			be created
+             */
+            Notifier();
+
+            Notifier(const Notifier&) = delete;
+            Notifier(Notifier&&) = delete;
+
+            /**
+             * @brief 	Destructs a Notifier, closing its descriptor
+             */
+            ~Notifier() { close(descriptor); }
+
+            /**
+             * @brief 	Gets the pollable file descriptor
+             * @return 	The eventfd, owned by the Notifier
+             */
+            int fd() const { return descriptor; }
+
+            /**
+             * @brief 	Marks the descriptor readable
+             * @note 	Called by the buffer on an empty to non-empty
+             * 			transition
+             */
+            void filled() override;
+
+            /**
+             * @brief 	Clears the descriptor
+             * @note 	Called by the buffer once it has been drained
+             */
+            void drained() override;
+    };
+
+    inline Notifier::Notifier()
+        : descriptor(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+        if (descriptor < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "eventfd");
+    }
+
+    inline void Notifier::filled() {
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto n = write(descriptor, &one, sizeof(one));
+    }
+
+    inline void Notifier::drained() {
+        std::uint64_t count;
+        [[maybe_unused]] auto n = read(descriptor, &count, sizeof(count));
+    }
+} // namespace piper
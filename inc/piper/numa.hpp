@@ -0,0 +1,302 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		numa.hpp
+ * @brief 		NUMA and page size hints for channel storage
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace piper {
+    /**
+     * @struct 	Placement
+     * @brief 	Where the memory backing a channel's storage should
+     * 			live, and on which size of page
+     * @details Pass the node of the thread that touches the storage
+     * 			most, usually the consumer, to on(). Placement is a
+     * 			hint: it is ignored where NUMA policy is unavailable,
+     * 			and memory falls back to other nodes when the chosen
+     * 			node is full. Likewise, huge pages fall back to
+     * 			transparent huge pages, and those to normal pages.
+     */
+    struct Placement {
+            enum class Policy {
+                /// Leave placement to the allocator and first touch
+                none,
+                /// Prefer a single node
+                node,
+                /// Interleave pages across every allowed node
+                interleave,
+            };
+
+            enum class Pages {
+                /// Use the base page size
+                normal,
+                /// Advise the kernel to back the storage with
+                /// transparent huge pages
+                transparent,
+                /// Map the storage from the reserved huge page pool
+                huge,
+            };
+
+            Policy policy = Policy::none;
+            int node = -1;
+            Pages pages = Pages::normal;
+
+            /// Prefers the given node
+            static Placement on(int node) { return {Policy::node, node}; }
+
+            /// Prefers the node of the calling thread
+            static Placement local() { return on(current_node()); }
+
+            /// Interleaves pages across every allowed node
+            static Placement interleaved() { return {Policy::interleave, -1}; }
+
+            /// Copies the placement with another page size
+            Placement with(Pages pages) const {
+                auto placement = *this;
+                placement.pages = pages;
+                return placement;
+            }
+
+            /**
+             * @brief 	Gets the default huge page size
+             * @return 	The size in bytes, or 2 MiB if it cannot be read
+             */
+            static std::size_t huge_page_size();
+
+            /**
+             * @brief 	Gets the NUMA node of the calling thread
+             * @return 	The node, or 0 if it cannot be determined
+             */
+            static int current_node();
+
+            /**
+             * @brief 	Applies the placement to a range of memory
+             * @param 	address The start of the range
+             * @param 	length The length of the range in bytes
+             * @note 	Pages already touched are migrated; failures are
+             * 			ignored.
+             */
+            void apply(void* address, std::size_t length) const;
+    };
+
+    inline int Placement::current_node() {
+#ifdef __linux__
+        unsigned cpu = 0, node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+            return static_cast<int>(node);
+#endif
+        return 0;
+    }
+
+    inline std::size_t Placement::huge_page_size() {
+        static const std::size_t size = [] {
+            std::ifstream meminfo("/proc/meminfo");
+            std::string key;
+            std::size_t kilobytes;
+            while (meminfo >> key >> kilobytes) {
+                if (key == "Hugepagesize:")
+                    return kilobytes * 1024;
+                meminfo.ignore(256, '\n');
+            }
+            return std::size_t(2) << 20;
+        }();
+        return size;
+    }
+
+    inline void Placement::apply(void* address, std::size_t length) const {
+#ifdef __linux__
+        if (policy == Policy::none || length == 0)
+            return;
+
+        constexpr unsigned long bits = 8 * sizeof(unsigned long);
+        constexpr unsigned long nodes = 1024;
+        unsigned long mask[nodes / bits] = {};
+
+        int mode;
+        if (policy == Policy::node) {
+            if (node < 0 || static_cast<unsigned long>(node) >= nodes)
+                return;
+            mask[node / bits] = 1ul << (node % bits);
+            mode = MPOL_PREFERRED;
+        } else {
+            if (syscall(SYS_get_mempolicy, nullptr, mask, nodes, nullptr,
+                        MPOL_F_MEMS_ALLOWED) != 0)
+                return;
+            mode = MPOL_INTERLEAVE;
+        }
+
+        // mbind works on whole pages
+        auto page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+        auto begin = reinterpret_cast<std::uintptr_t>(address) & ~(page - 1);
+        auto end = reinterpret_cast<std::uintptr_t>(address) + length;
+        syscall(SYS_mbind, begin, end - begin, mode, mask, nodes,
+                MPOL_MF_MOVE);
+#else
+        (void)address;
+        (void)length;
+#endif
+    }
+} // namespace piper
+
+namespace piper::internal {
+    /**
+     * @class 	PlacedArray
+     * @brief 	A fixed-size array whose pages follow a Placement
+     * @details With a placement, the array is mapped directly, sized
+     * 			and aligned to its pages, and bound before its
+     * 			elements are constructed, so the first touch already
+     * 			lands on the chosen node. Without one, it is
+     * 			allocated normally.
+     * @tparam 	T The type of element
+     */
+    template <typename T> class PlacedArray final {
+            T* items = nullptr;
+            std::size_t count = 0;
+            std::size_t length = 0;
+            Placement::Pages backing = Placement::Pages::normal;
+
+            /// Maps size bytes aligned to align, or returns nullptr
+            static void* map(std::size_t size, std::size_t align, int flags);
+
+        public:
+            /**
+             * @brief 	Constructs an array of value-initialized elements
+             * @param 	n The number of elements
+             * @param 	placement Where the elements should live
+             */
+            PlacedArray(std::size_t n, Placement placement = {});
+
+            PlacedArray(const PlacedArray<T>&) = delete;
+            PlacedArray(PlacedArray<T>&&) = delete;
+
+            ~PlacedArray();
+
+            T& operator[](std::size_t i) { return items[i]; }
+            const T& operator[](std::size_t i) const { return items[i]; }
+
+            /// Gets the kind of page the array was given
+            Placement::Pages pages() const { return backing; }
+    };
+
+    template <typename T>
+    void* PlacedArray<T>::map(std::size_t size, std::size_t align,
+                              int flags) {
+#ifdef __linux__
+        // Over-map, then trim the ends to reach the alignment
+        auto extra = align > 1 ? align : 0;
+        auto address = mmap(nullptr, size + extra, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+        if (address == MAP_FAILED)
+            return nullptr;
+        if (!extra)
+            return address;
+
+        auto start = reinterpret_cast<std::uintptr_t>(address);
+        auto aligned = (start + align - 1) & ~(align - 1);
+        if (aligned > start)
+            munmap(address, aligned - start);
+        if (auto tail = start + extra - aligned)
+            munmap(reinterpret_cast<void*>(aligned + size), tail);
+        return reinterpret_cast<void*>(aligned);
+#else
+        (void)size;
+        (void)align;
+        (void)flags;
+        return nullptr;
+#endif
+    }
+
+    template <typename T>
+    PlacedArray<T>::PlacedArray(std::size_t n, Placement placement)
+        : count(n) {
+#ifdef __linux__
+        using Pages = Placement::Pages;
+        auto round = [&](std::size_t page) {
+            return (n * sizeof(T) + page - 1) / page * page;
+        };
+        void* address = nullptr;
+
+        if (placement.pages == Pages::huge) {
+            length = round(Placement::huge_page_size());
+            address = map(length, 0, MAP_HUGETLB);
+            backing = Pages::huge;
+        }
+        if (!address && placement.pages != Pages::normal) {
+            auto huge = Placement::huge_page_size();
+            length = round(huge);
+            address = map(length, huge, 0);
+            backing = Pages::transparent;
+            if (address && madvise(address, length, MADV_HUGEPAGE) != 0)
+                backing = Pages::normal;
+        }
+        if (!address && placement.policy != Placement::Policy::none) {
+            length = round(static_cast<std::size_t>(sysconf(_SC_PAGESIZE)));
+            address = map(length, 0, 0);
+            backing = Pages::normal;
+        }
+
+        if (address) {
+            placement.apply(address, length);
+            items = static_cast<T*>(address);
+        } else {
+            length = 0;
+            backing = Pages::normal;
+        }
+#endif
+        if (!items)
+            items = std::allocator<T>().allocate(n);
+        std::uninitialized_value_construct_n(items, n);
+    }
+
+    template <typename T> PlacedArray<T>::~PlacedArray() {
+        std::destroy_n(items, count);
+#ifdef __linux__
+        if (length) {
+            munmap(items, length);
+            return;
+        }
+#endif
+        std::allocator<T>().deallocate(items, count);
+    }
+} // namespace piper::internal
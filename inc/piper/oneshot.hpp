@@ -0,0 +1,325 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		oneshot.hpp
+ * @brief 		Lock-free channel for a single value
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "piper/piper.hpp"
+
+namespace piper::oneshot::internal {
+    /**
+     * @class 	State
+     * @brief 	Shared state of a oneshot channel
+     * @details A single atomic word records whether the value has been
+     * 			stored and taken and whether each end is gone. The
+     * 			value lives inline, and the last end to go frees the
+     * 			state.
+     * @tparam 	T The type of the value
+     */
+    template <typename T> class State {
+            alignas(T) unsigned char storage[sizeof(T)];
+            std::atomic<std::uint32_t> word{0};
+
+            T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+        public:
+            /// The value is stored
+            static constexpr std::uint32_t stored = 1;
+
+            /// The value has been taken by the receiver
+            static constexpr std::uint32_t taken = 2;
+
+            /// The sender was dropped without sending
+            static constexpr std::uint32_t closed = 4;
+
+            /// The sender is gone
+            static constexpr std::uint32_t sender = 8;
+
+            /// The receiver is gone
+            static constexpr std::uint32_t receiver = 16;
+
+            ~State() {
+                auto state = word.load(std::memory_order_acquire);
+                if ((state & stored) && !(state & taken))
+                    value()->~T();
+            }
+
+            /**
+             * @brief 	Stores the value, wakes the receiver and releases
+             * 			the sender
+             * @param 	item The value, forwarded to T's constructor
+             * @throws 	std::runtime_error Thrown if the receiver is gone
+             */
+            template <typename U> void send(U&& item);
+
+            /**
+             * @brief 	Wakes the receiver without a value and releases
+             * 			the sender
+             */
+            void close();
+
+            /**
+             * @brief 	Takes the value if it has been stored
+             * @param 	block Whether to wait for the value
+             * @return 	The value, or std::nullopt if it has not been
+             * 			stored
+             * @throws 	std::runtime_error Thrown if the sender is gone
+             * 			without sending
+             * @throws 	std::logic_error Thrown if the value was taken
+             */
+            std::optional<T> take(bool block);
+
+            /**
+             * @brief 	Marks one end as gone, freeing the state if the
+             * 			other end is gone too
+             * @param 	end Either sender or receiver
+             * @note 	The state must not be touched after this call
+             */
+            void release(std::uint32_t end);
+    };
+
+    template <typename T>
+    template <typename U>
+    void State<T>::send(U&& item) {
+        if (word.load(std::memory_order_relaxed) & receiver) {
+            release(sender);
+            throw std::runtime_error("receiver is expired");
+        }
+
+        try {
+            new (storage) T(std::forward<U>(item));
+        } catch (...) {
+            close();
+            throw;
+        }
+
+        // Wake the receiver before releasing, since the receiver may
+        // free the state as soon as the sender is gone
+        word.fetch_or(stored, std::memory_order_release);
+        word.notify_one();
+        release(sender);
+    }
+
+    template <typename T> void State<T>::close() {
+        word.fetch_or(closed, std::memory_order_release);
+        word.notify_one();
+        release(sender);
+    }
+
+    template <typename T> std::optional<T> State<T>::take(bool block) {
+        auto state = word.load(std::memory_order_acquire);
+        while (!(state & (stored | closed))) {
+            if (!block)
+                return std::nullopt;
+            word.wait(state, std::memory_order_acquire);
+            state = word.load(std::memory_order_acquire);
+        }
+
+        if (state & taken)
+            throw std::logic_error("value is already received");
+        if (!(state & stored))
+            throw std::runtime_error("sender is expired");
+
+        std::optional<T> item(std::move(*value()));
+        value()->~T();
+        word.fetch_or(taken, std::memory_order_relaxed);
+        return item;
+    }
+
+    template <typename T> void State<T>::release(std::uint32_t end) {
+        auto other = end == sender ? receiver : sender;
+        if (word.fetch_or(end, std::memory_order_acq_rel) & other)
+            delete this;
+    }
+} // namespace piper::oneshot::internal
+
+/**
+ * @namespace 	piper::oneshot
+ * @brief 		Concrete Sender and Receiver implementations for
+ * 				channels that carry exactly one value
+ */
+namespace piper::oneshot {
+    template <typename T> class Sender;
+    template <typename T> class Receiver;
+
+    /**
+     * @brief 	Creates a connected Sender and Receiver
+     * @tparam 	T The type of the value
+     * @return 	The Sender and Receiver
+     * @note 	The only allocation is the shared state, which holds
+     * 			the value inline
+     */
+    template <typename T> std::pair<Sender<T>, Receiver<T>> channel();
+
+    /**
+     * @class 		Receiver
+     * @brief 		Oneshot channel receiver
+     * @tparam 		T The type of the value being received
+     * @implements	piper::Receiver
+     */
+    template <typename T> class Receiver : public piper::Receiver<T> {
+            internal::State<T>* state;
+
+            explicit Receiver(internal::State<T>* state) : state(state) {}
+
+            friend std::pair<Sender<T>, Receiver<T>> channel<T>();
+
+        public:
+            /**
+             * @brief 	Moves a Receiver
+             * @param 	rx The Receiver to move
+             */
+            Receiver(Receiver<T>&& rx)
+                : state(std::exchange(rx.state, nullptr)) {}
+
+            Receiver(const Receiver<T>&) = delete;
+
+            /**
+             * @brief 	Destructs a Receiver
+             */
+            ~Receiver() {
+                if (state)
+                    state->release(internal::State<T>::receiver);
+            }
+
+            /**
+             * @brief 	Receives the value
+             * @return 	The value sent over the channel
+             * @throws 	std::runtime_error Thrown if the Sender was
+             * 			dropped without sending
+             * @throws 	std::logic_error Thrown if the value was already
+             * 			received
+             * @note 	Blocks until the value is sent
+             */
+            T recv() override { return std::move(*state->take(true)); }
+
+            /**
+             * @brief 	Receives the value, if it has been sent
+             * @return 	The value sent over the channel, or std::nullopt
+             * 			if it has not been sent
+             * @throws 	std::runtime_error Thrown if the Sender was
+             * 			dropped without sending
+             * @throws 	std::logic_error Thrown if the value was already
+             * 			received
+             */
+            std::optional<T> try_recv() override { return state->take(false); }
+    };
+
+    /**
+     * @class 		Sender
+     * @brief 		Oneshot channel sender
+     * @tparam 		T The type of the value being sent
+     * @implements	piper::Sender
+     * @note 		Dropping a Sender without sending wakes the Receiver,
+     * 				which then throws.
+     */
+    template <typename T> class Sender : public piper::Sender<T> {
+            internal::State<T>* state;
+
+            explicit Sender(internal::State<T>* state) : state(state) {}
+
+            friend std::pair<Sender<T>, Receiver<T>> channel<T>();
+
+            template <typename U> void put(U&& item);
+
+        public:
+            /**
+             * @brief 	Moves a Sender
+             * @param 	tx The Sender to move
+             */
+            Sender(Sender<T>&& tx) : state(std::exchange(tx.state, nullptr)) {}
+
+            Sender(const Sender<T>&) = delete;
+
+            /**
+             * @brief 	Destructs a Sender
+             */
+            ~Sender() {
+                if (state)
+                    state->close();
+            }
+
+            /**
+             * @brief 	Copies and sends the value
+             * @param 	item The value being sent
+             * @throws 	std::runtime_error Thrown if the Receiver is
+             * 			expired
+             * @throws 	std::logic_error Thrown if a value was already
+             * 			sent, or if T is not copy constructible
+             * @note 	This method does not block
+             */
+            void send(const T& item) override;
+
+            /**
+             * @brief 	Moves and sends the value
+             * @param 	item The value being sent
+             * @throws 	std::runtime_error Thrown if the Receiver is
+             * 			expired
+             * @throws 	std::logic_error Thrown if a value was already
+             * 			sent
+             * @note 	This method does not block
+             */
+            void send(T&& item) override { put(std::move(item)); }
+    };
+
+    template <typename T> void Sender<T>::send(const T& item) {
+        if constexpr (std::is_copy_constructible_v<T>) {
+            put(item);
+        } else {
+            throw std::logic_error("item is not copy constructible");
+        }
+    }
+
+    template <typename T>
+    template <typename U>
+    void Sender<T>::put(U&& item) {
+        if (!state)
+            throw std::logic_error("value is already sent");
+
+        // The state may be freed by send, so give it up first
+        std::exchange(state, nullptr)->send(std::forward<U>(item));
+    }
+
+    template <typename T> std::pair<Sender<T>, Receiver<T>> channel() {
+        auto state = new internal::State<T>();
+        return {Sender<T>(state), Receiver<T>(state)};
+    }
+} // namespace piper::oneshot
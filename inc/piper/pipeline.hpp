@@ -0,0 +1,1223 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		pipeline.hpp
+ * @brief 		Composable pipeline operators
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "piper/batch.hpp"
+#include "piper/rate.hpp"
+#include "piper/window.hpp"
+#include "piper/internal/buffer.hpp"
+#include "piper/piper.hpp"
+#include "piper/stage.hpp"
+
+namespace piper::internal {
+    /**
+     * @class 	Link
+     * @brief 	A bounded buffer between two pipeline stages, which
+     * 			either side can close
+     * @details Once closed by its sender, the buffer hands out the
+     * 			items it still holds and then throws from pop() and
+     * 			try_pop(), so the next stage drains it and finishes.
+     * 			Closing also notifies the listener, to wake a stage
+     * 			waiting on an empty buffer.
+     * @tparam 	T The type of item stored in the buffer
+     */
+    template <typename T> class Link final : public SyncBuffer<T> {
+            bool closed = false;
+            bool abandoned = false;
+            std::size_t receivers = 1;
+
+        public:
+            explicit Link(std::size_t n) : SyncBuffer<T>(n) {}
+
+            /// Marks the sending side as gone
+            void close();
+
+            /// Counts another receiver
+            void share();
+
+            /// Marks a receiver as gone, and the receiving side once
+            /// every receiver is
+            void abandon();
+
+            using Buffer<T>::push;
+
+            /**
+             * @brief 	Moves and pushes an item into the buffer
+             * @param 	item The item being pushed into the buffer
+             * @throws 	std::runtime_error Thrown if the receiving side
+             * 			is gone
+             * @note 	Blocks on a full buffer
+             */
+            void push(T&& item) override;
+
+            /**
+             * @brief 	Pops an item from the buffer
+             * @return 	The item being popped from the buffer
+             * @throws 	std::runtime_error Thrown if the buffer is
+             * 			closed and empty
+             * @note 	Blocks on an empty buffer
+             */
+            T pop() override;
+
+            /**
+             * @brief 	Pops an item from the buffer, if one is available
+             * @return 	The item, or std::nullopt if the buffer is empty
+             * @throws 	std::runtime_error Thrown if the buffer is
+             * 			closed and empty
+             */
+            std::optional<T> try_pop() override;
+    };
+
+    /// The sending end of a Link, which closes it on destruction
+    template <typename T> class LinkSender final : public piper::Sender<T> {
+            std::shared_ptr<Link<T>> link;
+
+        public:
+            explicit LinkSender(std::shared_ptr<Link<T>> link)
+                : link(std::move(link)) {}
+            LinkSender(LinkSender<T>&&) = default;
+            LinkSender(const LinkSender<T>&) = delete;
+
+            ~LinkSender() {
+                if (link)
+                    link->close();
+            }
+
+            void send(const T& item) override {
+                if constexpr (std::is_copy_constructible_v<T>) {
+                    link->push(item);
+                } else {
+                    throw std::logic_error("item is not copy constructible");
+                }
+            }
+            void send(T&& item) override { link->push(std::move(item)); }
+    };
+
+    /// The receiving end of a Link, which abandons it on destruction
+    template <typename T>
+    class LinkReceiver final : public piper::Receiver<T> {
+            std::shared_ptr<Link<T>> link;
+
+        public:
+            explicit LinkReceiver(std::shared_ptr<Link<T>> link)
+                : link(std::move(link)) {}
+            LinkReceiver(LinkReceiver<T>&&) = default;
+            LinkReceiver(const LinkReceiver<T>&) = delete;
+
+            ~LinkReceiver() {
+                if (link)
+                    link->abandon();
+            }
+
+            T recv() override { return link->pop(); }
+            std::optional<T> try_recv() override { return link->try_pop(); }
+
+            void listen(std::shared_ptr<Listener> listener) {
+                link->listen(std::move(listener));
+            }
+    };
+
+    /**
+     * @brief 	A receiving end of a Link shared by several stages
+     * @note 	A buffer has only one listener, so stages sharing a link
+     * 			block in recv() instead, and finish once it is closed.
+     */
+    template <typename T>
+    class SharedLinkReceiver final : public piper::Receiver<T> {
+            std::shared_ptr<Link<T>> link;
+
+        public:
+            explicit SharedLinkReceiver(std::shared_ptr<Link<T>> link)
+                : link(std::move(link)) {}
+            SharedLinkReceiver(SharedLinkReceiver<T>&&) = default;
+
+            SharedLinkReceiver(const SharedLinkReceiver<T>& rx)
+                : link(rx.link) {
+                link->share();
+            }
+
+            ~SharedLinkReceiver() {
+                if (link)
+                    link->abandon();
+            }
+
+            T recv() override { return link->pop(); }
+            std::optional<T> try_recv() override { return link->try_pop(); }
+    };
+
+    template <typename T> void Link<T>::close() {
+        {
+            auto lock = std::unique_lock(this->mutex);
+            closed = true;
+            this->filled();
+        }
+        this->available[0].notify_all();
+    }
+
+    template <typename T> void Link<T>::abandon() {
+        {
+            auto lock = std::unique_lock(this->mutex);
+            abandoned = --receivers == 0;
+        }
+        this->available[1].notify_all();
+    }
+
+    template <typename T> void Link<T>::share() {
+        auto lock = std::unique_lock(this->mutex);
+        receivers++;
+    }
+
+    template <typename T> void Link<T>::push(T&& item) {
+        {
+            auto lock = std::unique_lock(this->mutex);
+            this->available[1].wait(lock, [this] {
+                return abandoned || this->queue.size() < this->n;
+            });
+            if (abandoned)
+                throw std::runtime_error("receiver is expired");
+
+            this->queue.push_back(std::move(item));
+            if (this->queue.size() == 1)
+                this->filled();
+        }
+        this->available[0].notify_one();
+    }
+
+    template <typename T> T Link<T>::pop() {
+        std::optional<T> item;
+        {
+            auto lock = std::unique_lock(this->mutex);
+            this->available[0].wait(
+                lock, [this] { return closed || !this->queue.empty(); });
+            if (this->queue.empty())
+                throw std::runtime_error("sender is closed");
+            item.emplace(this->take());
+        }
+        this->available[1].notify_one();
+        return std::move(*item);
+    }
+
+    template <typename T> std::optional<T> Link<T>::try_pop() {
+        std::optional<T> item;
+        {
+            auto lock = std::unique_lock(this->mutex);
+            if (this->queue.empty()) {
+                if (closed)
+                    throw std::runtime_error("sender is closed");
+                return std::nullopt;
+            }
+            item.emplace(this->take());
+        }
+        this->available[1].notify_one();
+        return item;
+    }
+
+    /**
+     * @class 	Reorder
+     * @brief 	A bounded buffer that hands out items in sequence order
+     * @details Writers put items tagged with consecutive sequence
+     * 			numbers, in any order, into a ring of window slots.
+     * 			A writer blocks while its item is a full window ahead
+     * 			of the next one to be popped, which also bounds how far
+     * 			the writers run ahead of a slow item. An item that
+     * 			failed is put as a hole and skipped. Once every writer
+     * 			has finished and the ring is drained, popping throws.
+     * @tparam 	T The type of item stored in the buffer
+     */
+    template <typename T> class Reorder final {
+            std::mutex mutex;
+            std::condition_variable available[2];
+            std::shared_ptr<Listener> listener;
+
+            std::vector<std::optional<T>> slots;
+            std::vector<bool> ready;
+            std::uint64_t next = 0;
+            std::size_t writers = 0;
+
+            /// Skips holes, and checks whether the next item is ready
+            bool advance();
+
+            /// Removes the next item, with the lock held
+            T take();
+
+        public:
+            /**
+             * @brief 	Constructs a Reorder buffer
+             * @param 	window The number of slots, at least 1
+             */
+            explicit Reorder(std::size_t window)
+                : slots(std::max<std::size_t>(window, 1)),
+                  ready(slots.size(), false) {}
+
+            /// Counts another writer
+            void join();
+
+            /// Marks a writer as finished
+            void leave();
+
+            /**
+             * @brief 	Puts an item into its slot
+             * @param 	sequence The item's sequence number
+             * @param 	item The item, or std::nullopt for a hole
+             * @note 	Blocks while the slot is a full window ahead
+             */
+            void put(std::uint64_t sequence, std::optional<T> item);
+
+            /**
+             * @brief 	Pops the next item in sequence
+             * @throws 	std::runtime_error Thrown once every writer has
+             * 			finished and the buffer is drained
+             * @note 	Blocks until the next item is ready
+             */
+            T pop();
+
+            /**
+             * @brief 	Pops the next item in sequence, if it is ready
+             * @throws 	std::runtime_error Thrown once every writer has
+             * 			finished and the buffer is drained
+             */
+            std::optional<T> try_pop();
+
+            /// Attaches a listener, notified when the next item is ready
+            void listen(std::shared_ptr<Listener> listener);
+    };
+
+    /// A writer of a Reorder buffer, which leaves it on destruction
+    template <typename T> class ReorderWriter final {
+            std::shared_ptr<Reorder<T>> reorder;
+
+        public:
+            explicit ReorderWriter(std::shared_ptr<Reorder<T>> reorder)
+                : reorder(std::move(reorder)) {
+                this->reorder->join();
+            }
+            ReorderWriter(ReorderWriter<T>&&) = default;
+            ReorderWriter(const ReorderWriter<T>& writer)
+                : ReorderWriter(writer.reorder) {}
+
+            ~ReorderWriter() {
+                if (reorder)
+                    reorder->leave();
+            }
+
+            void put(std::uint64_t sequence, std::optional<T> item) {
+                reorder->put(sequence, std::move(item));
+            }
+    };
+
+    /// The receiving end of a Reorder buffer
+    template <typename T>
+    class ReorderReceiver final : public piper::Receiver<T> {
+            std::shared_ptr<Reorder<T>> reorder;
+
+        public:
+            explicit ReorderReceiver(std::shared_ptr<Reorder<T>> reorder)
+                : reorder(std::move(reorder)) {}
+            ReorderReceiver(ReorderReceiver<T>&&) = default;
+            ReorderReceiver(const ReorderReceiver<T>&) = delete;
+
+            T recv() override { return reorder->pop(); }
+            std::optional<T> try_recv() override {
+                return reorder->try_pop();
+            }
+
+            void listen(std::shared_ptr<Listener> listener) {
+                reorder->listen(std::move(listener));
+            }
+    };
+
+    /**
+     * @class 	Failure
+     * @brief 	The first exception thrown by a stage that keeps running
+     * @details A parallel_map worker records the exception of a failed
+     * 			item here rather than exiting, and Pipeline::join()
+     * 			rethrows it.
+     */
+    class Failure final {
+            std::mutex mutex;
+            std::exception_ptr error;
+
+        public:
+            /// Records an exception, unless one was recorded before
+            void record(std::exception_ptr error) {
+                std::lock_guard lock(mutex);
+                if (!this->error)
+                    this->error = std::move(error);
+            }
+
+            /// Gets the recorded exception, if any
+            std::exception_ptr get() {
+                std::lock_guard lock(mutex);
+                return error;
+            }
+    };
+
+    template <typename T> bool Reorder<T>::advance() {
+        for (;;) {
+            auto i = next % slots.size();
+            if (!ready[i])
+                return false;
+            if (slots[i])
+                return true;
+            ready[i] = false;
+            next++;
+            available[1].notify_all();
+        }
+    }
+
+    template <typename T> T Reorder<T>::take() {
+        auto i = next % slots.size();
+        T item = std::move(*slots[i]);
+        slots[i].reset();
+        ready[i] = false;
+        next++;
+        return item;
+    }
+
+    template <typename T> void Reorder<T>::join() {
+        auto lock = std::unique_lock(mutex);
+        writers++;
+    }
+
+    template <typename T> void Reorder<T>::leave() {
+        {
+            auto lock = std::unique_lock(mutex);
+            if (--writers == 0 && listener)
+                listener->filled();
+        }
+        available[0].notify_all();
+    }
+
+    template <typename T>
+    void Reorder<T>::put(std::uint64_t sequence, std::optional<T> item) {
+        {
+            auto lock = std::unique_lock(mutex);
+            available[1].wait(
+                lock, [&] { return sequence < next + slots.size(); });
+
+            auto i = sequence % slots.size();
+            slots[i] = std::move(item);
+            ready[i] = true;
+            if (sequence == next && listener)
+                listener->filled();
+        }
+        available[0].notify_all();
+    }
+
+    template <typename T> T Reorder<T>::pop() {
+        std::optional<T> item;
+        {
+            auto lock = std::unique_lock(mutex);
+            available[0].wait(lock, [this] { return advance() || !writers; });
+            if (!advance())
+                throw std::runtime_error("sender is closed");
+            item.emplace(take());
+        }
+        available[1].notify_all();
+        return std::move(*item);
+    }
+
+    template <typename T> std::optional<T> Reorder<T>::try_pop() {
+        std::optional<T> item;
+        {
+            auto lock = std::unique_lock(mutex);
+            if (!advance()) {
+                if (!writers)
+                    throw std::runtime_error("sender is closed");
+                return std::nullopt;
+            }
+            item.emplace(take());
+        }
+        available[1].notify_all();
+        return item;
+    }
+
+    template <typename T>
+    void Reorder<T>::listen(std::shared_ptr<Listener> listener) {
+        auto lock = std::unique_lock(mutex);
+        this->listener = std::move(listener);
+        if (this->listener && (advance() || !writers))
+            this->listener->filled();
+    }
+
+    /// The operator of an empty segment, which passes items through
+    struct Identity {
+            template <typename In> using Output = In;
+
+            template <typename T, typename Emit>
+            void operator()(T&& item, Emit&& emit) {
+                emit(std::forward<T>(item));
+            }
+    };
+
+    /// Two operators fused to run on one thread
+    template <typename First, typename Second> struct Fused {
+            First first;
+            Second second;
+
+            template <typename In>
+            using Output = typename Second::template Output<
+                typename First::template Output<In>>;
+
+            template <typename T, typename Emit>
+            void operator()(T&& item, Emit&& emit) {
+                first(std::forward<T>(item), [&](auto&& next) {
+                    second(std::forward<decltype(next)>(next), emit);
+                });
+            }
+    };
+
+    /// Whether Rx can start a pipeline
+    template <typename Rx>
+    concept Source = requires(Rx& rx) {
+        rx.recv();
+        rx.try_recv();
+    };
+} // namespace piper::internal
+
+namespace piper {
+    /**
+     * @struct 	Map
+     * @brief 	A pipeline operator that replaces each item with f(item)
+     */
+    template <typename F> struct Map {
+            F f;
+
+            template <typename In>
+            using Output = std::remove_cvref_t<std::invoke_result_t<F&, In>>;
+
+            template <typename T, typename Emit>
+            void operator()(T&& item, Emit&& emit) {
+                emit(f(std::forward<T>(item)));
+            }
+    };
+
+    /**
+     * @struct 	Filter
+     * @brief 	A pipeline operator that keeps the items for which p
+     * 			returns true
+     */
+    template <typename P> struct Filter {
+            P p;
+
+            template <typename In> using Output = In;
+
+            template <typename T, typename Emit>
+            void operator()(T&& item, Emit&& emit) {
+                if (p(std::as_const(item)))
+                    emit(std::forward<T>(item));
+            }
+    };
+
+    /**
+     * @struct 	FlatMap
+     * @brief 	A pipeline operator that replaces each item with every
+     * 			element of the range f(item)
+     */
+    template <typename F> struct FlatMap {
+            F f;
+
+            template <typename In>
+            using Output = std::ranges::range_value_t<
+                std::remove_cvref_t<std::invoke_result_t<F&, In>>>;
+
+            template <typename T, typename Emit>
+            void operator()(T&& item, Emit&& emit) {
+                for (auto&& element : f(std::forward<T>(item))) {
+                    emit(std::forward<decltype(element)>(element));
+                }
+            }
+    };
+
+    /**
+     * @struct 	RateLimit
+     * @brief 	A pipeline operator that passes items on no faster than
+     * 			its token bucket allows
+     */
+    struct RateLimit {
+            internal::Allowance allowance;
+
+            template <typename In> using Output = In;
+
+            template <typename T, typename Emit>
+            void operator()(T&& item, Emit&& emit) {
+                allowance.spend();
+                emit(std::forward<T>(item));
+            }
+    };
+
+    /**
+     * @struct 	ForEach
+     * @brief 	A pipeline sink that calls f with each item
+     */
+    template <typename F> struct ForEach {
+            F f;
+    };
+
+    /**
+     * @struct 	Spawn
+     * @brief 	An operator or sink that starts a new stage, on its own
+     * 			thread, instead of fusing with the one before it
+     */
+    template <typename Op> struct Spawn {
+            Op op;
+            Stage::Options options;
+    };
+
+    /**
+     * @struct 	ParallelMap
+     * @brief 	A pipeline operator that replaces each item with f(item)
+     * 			on several workers, keeping the items in order
+     */
+    template <typename F> struct ParallelMap {
+            F f;
+            std::size_t workers;
+            std::size_t window;
+            Stage::Options options;
+    };
+
+    /**
+     * @struct 	Batch
+     * @brief 	A pipeline operator that gathers items into batches
+     * @see 	Batcher
+     */
+    struct Batch {
+            std::size_t max_items;
+            std::chrono::nanoseconds max_delay;
+            bool adaptive;
+            Stage::Options options;
+    };
+
+    /**
+     * @struct 	Windowed
+     * @brief 	A pipeline operator that aggregates items over windows
+     * @see 	Windower
+     */
+    template <typename R, typename Time> struct Windowed {
+            Windowing shape;
+            R reducer;
+            Time time;
+            Stage::Options options;
+    };
+
+    /// Whether Op is a fusable pipeline operator
+    template <typename Op> inline constexpr bool is_operator = false;
+    template <typename F> inline constexpr bool is_operator<Map<F>> = true;
+    template <typename P> inline constexpr bool is_operator<Filter<P>> = true;
+    template <typename F>
+    inline constexpr bool is_operator<FlatMap<F>> = true;
+    template <> inline constexpr bool is_operator<RateLimit> = true;
+
+    /**
+     * @class 	Pipeline
+     * @brief 	The stages built by connecting a source to a sink
+     * @details The first stage runs until its source expires or
+     * 			stop() is called. Each later stage finishes once it has
+     * 			drained the stage before it, so stopping a pipeline
+     * 			still delivers every item already inside it.
+     */
+    class Pipeline {
+            std::vector<Stage> stages;
+            std::vector<std::shared_ptr<internal::Failure>> failures;
+
+        public:
+            explicit Pipeline(
+                std::vector<Stage> stages,
+                std::vector<std::shared_ptr<internal::Failure>> failures = {})
+                : stages(std::move(stages)), failures(std::move(failures)) {}
+
+            Pipeline(Pipeline&&) = default;
+            Pipeline(const Pipeline&) = delete;
+
+            /**
+             * @brief 	Destructs a Pipeline, stopping it and waiting for
+             * 			it to drain
+             * @note 	Exceptions thrown by stages are discarded; call
+             * 			join() to observe them.
+             */
+            ~Pipeline();
+
+            /// Stops taking items from the source
+            void stop();
+
+            /**
+             * @brief 	Waits for every stage to finish
+             * @details Once a stage fails, the source is stopped, and
+             * 			the stages before it end as they find their
+             * 			downstream gone.
+             * @throws 	The first exception thrown by a stage's function,
+             * 			or else by a parallel_map function
+             */
+            void join();
+
+            /// Gets the number of stages, each running on its own thread
+            std::size_t size() const { return stages.size(); }
+    };
+
+    /**
+     * @class 	Flow
+     * @brief 	A pipeline under construction
+     * @details Holds the stages started so far, and the source and
+     * 			fused operators of the stage still being built. That
+     * 			stage starts once a sink, or an operator spawning a new
+     * 			stage, is appended.
+     * @tparam 	Rx The type of the stage's source
+     * @tparam 	Chain The fused operators of the stage
+     */
+    template <typename Rx, typename Chain = internal::Identity>
+    class Flow {
+            template <typename, typename> friend class Flow;
+
+        public:
+            /// The type of item taken from the source
+            using In = std::remove_cvref_t<decltype(std::declval<Rx&>()
+                                                        .recv())>;
+
+            /// The type of item produced by the stage
+            using Out = typename Chain::template Output<In>;
+
+            /// The capacity of the links between stages
+            static constexpr std::size_t capacity = 1024;
+
+        private:
+            Rx rx;
+            Chain chain;
+            Stage::Options options;
+            std::vector<Stage> stages;
+            std::vector<std::shared_ptr<internal::Failure>> failures;
+
+            /// Starts the stage, passing its items to sink
+            template <typename Sink> Stage start(Sink sink) &&;
+
+        public:
+            /**
+             * @brief 	Constructs a Flow from a source
+             * @param 	rx The source, owned by the flow
+             */
+            explicit Flow(Rx rx, Chain chain = {},
+                          Stage::Options options = {},
+                          std::vector<Stage> stages = {},
+                          std::vector<std::shared_ptr<internal::Failure>>
+                              failures = {})
+                : rx(std::move(rx)), chain(std::move(chain)),
+                  options(std::move(options)), stages(std::move(stages)),
+                  failures(std::move(failures)) {}
+
+            /**
+             * @brief 	Fuses an operator into the stage
+             * @param 	op The operator
+             * @return 	The extended flow
+             */
+            template <typename Op> Flow<Rx, internal::Fused<Chain, Op>>
+            then(Op op) && {
+                return Flow<Rx, internal::Fused<Chain, Op>>(
+                    std::move(rx), {std::move(chain), std::move(op)},
+                    std::move(options), std::move(stages),
+                    std::move(failures));
+            }
+
+            /**
+             * @brief 	Starts the stage, and begins another one reading
+             * 			from it
+             * @param 	next How the new stage's thread is set up
+             * @return 	The flow of the new stage
+             */
+            Flow<internal::LinkReceiver<Out>> spawn(Stage::Options next) &&;
+
+            /**
+             * @brief 	Starts the stage, feeding a set of workers that
+             * 			apply a function in parallel, and begins another
+             * 			stage reading their results in order
+             * @param 	op The function and the shape of the workers
+             * @return 	The flow of the new stage
+             */
+            template <typename F>
+            Flow<internal::ReorderReceiver<
+                std::remove_cvref_t<std::invoke_result_t<F&, Out>>>>
+            parallel(ParallelMap<F> op) &&;
+
+            /**
+             * @brief 	Begins a stage reading batches of this stage's
+             * 			items
+             * @param 	op The shape of the batches
+             * @return 	The flow of the new stage
+             */
+            auto batched(Batch op) &&;
+
+            /**
+             * @brief 	Begins a stage reading aggregates of windows of
+             * 			this stage's items
+             * @param 	op The windows and how they are aggregated
+             * @return 	The flow of the new stage
+             */
+            template <typename R, typename Time>
+            auto windowed(Windowed<R, Time> op) &&;
+
+            /**
+             * @brief 	Starts the stage, ending the pipeline in a sink
+             * @param 	sink Called with each item produced
+             * @return 	The pipeline
+             */
+            template <typename F> Pipeline finish(F sink) &&;
+
+            /// Sets up the thread of a stage without operators
+            Flow<Rx, Chain> with(Stage::Options next) &&
+                requires std::is_same_v<Chain, internal::Identity>
+            {
+                options = std::move(next);
+                return std::move(*this);
+            }
+    };
+
+    /**
+     * @brief 	Creates an operator that replaces each item with f(item)
+     * @param 	f The function
+     */
+    template <typename F> Map<F> map(F f) { return {std::move(f)}; }
+
+    /**
+     * @brief 	Creates an operator that replaces each item with
+     * 			f(item), in a new stage
+     * @param 	f The function
+     * @param 	options How the new stage's thread is set up
+     */
+    template <typename F> Spawn<Map<F>> map(F f, Stage::Options options) {
+        return {{std::move(f)}, std::move(options)};
+    }
+
+    /**
+     * @brief 	Creates an operator that keeps items satisfying p
+     * @param 	p The predicate
+     */
+    template <typename P> Filter<P> filter(P p) { return {std::move(p)}; }
+
+    /**
+     * @brief 	Creates an operator that keeps items satisfying p, in a
+     * 			new stage
+     * @param 	p The predicate
+     * @param 	options How the new stage's thread is set up
+     */
+    template <typename P>
+    Spawn<Filter<P>> filter(P p, Stage::Options options) {
+        return {{std::move(p)}, std::move(options)};
+    }
+
+    /**
+     * @brief 	Creates an operator that replaces each item with the
+     * 			elements of the range f(item)
+     * @param 	f The function
+     */
+    template <typename F> FlatMap<F> flat_map(F f) { return {std::move(f)}; }
+
+    /**
+     * @brief 	Creates an operator that replaces each item with the
+     * 			elements of the range f(item), in a new stage
+     * @param 	f The function
+     * @param 	options How the new stage's thread is set up
+     */
+    template <typename F>
+    Spawn<FlatMap<F>> flat_map(F f, Stage::Options options) {
+        return {{std::move(f)}, std::move(options)};
+    }
+
+    /**
+     * @brief 	Creates an operator that replaces each item with f(item)
+     * 			on several workers, keeping the items in order
+     * @param 	f The function, called concurrently
+     * @param 	workers The number of worker stages
+     * @param 	window The number of items that may be in flight, at
+     * 			least workers
+     * @param 	options How the workers' threads are set up; a name is
+     * 			suffixed with each worker's index
+     */
+    template <typename F>
+    ParallelMap<F> parallel_map(F f, std::size_t workers, std::size_t window,
+                                Stage::Options options = {}) {
+        return {std::move(f), std::max<std::size_t>(workers, 1),
+                std::max(window, workers), std::move(options)};
+    }
+
+    /**
+     * @brief 	Creates an operator that gathers items into batches,
+     * 			handed on at max_items or after max_delay
+     * @param 	max_items The largest batch
+     * @param 	max_delay The longest an item waits in a batch
+     * @param 	adaptive Whether to adapt the batch size to the arrival
+     * 			rate
+     * @param 	options How the stage's thread is set up
+     */
+    inline Batch batch(std::size_t max_items,
+                       std::chrono::nanoseconds max_delay,
+                       bool adaptive = false, Stage::Options options = {}) {
+        return {max_items, max_delay, adaptive, std::move(options)};
+    }
+
+    /**
+     * @brief 	Creates an operator that passes on at most rate items
+     * 			per second
+     * @param 	rate The most items per second
+     * @param 	burst The most items passed back to back after an idle
+     * 			period
+     */
+    inline RateLimit rate_limit(double rate, std::size_t burst = 1) {
+        return {{std::make_shared<TokenBucket>(rate, burst), 1}};
+    }
+
+    /**
+     * @brief 	Creates an operator that passes on at most rate items
+     * 			per second, in a new stage
+     * @param 	rate The most items per second
+     * @param 	burst The most items passed back to back after an idle
+     * 			period
+     * @param 	options How the new stage's thread is set up
+     */
+    inline Spawn<RateLimit> rate_limit(double rate, std::size_t burst,
+                                       Stage::Options options) {
+        return {rate_limit(rate, burst), std::move(options)};
+    }
+
+    /**
+     * @brief 	Creates an operator limited by a shared token bucket
+     * @param 	bucket The bucket, e.g. shared with RateLimitedSenders
+     * 			or other pipelines
+     * @param 	batch The number of tokens taken from it at a time
+     */
+    inline RateLimit rate_limit(std::shared_ptr<TokenBucket> bucket,
+                                std::size_t batch = 1) {
+        return {{std::move(bucket), batch}};
+    }
+
+    /**
+     * @brief 	Creates an operator that aggregates items over windows
+     * @param 	shape The windows, e.g. piper::tumbling(1s)
+     * @param 	reducer How the items of a window are aggregated
+     * @param 	time How items are timestamped
+     * @param 	options How the stage's thread is set up
+     */
+    template <typename R, typename Time = ProcessingTime>
+    Windowed<R, Time> window(Windowing shape, R reducer, Time time = {},
+                             Stage::Options options = {}) {
+        return {shape, std::move(reducer), std::move(time),
+                std::move(options)};
+    }
+
+    /**
+     * @brief 	Creates a sink that calls f with each item
+     * @param 	f The function
+     */
+    template <typename F> ForEach<F> for_each(F f) { return {std::move(f)}; }
+
+    /**
+     * @brief 	Creates a sink that calls f with each item, in a new
+     * 			stage
+     * @param 	f The function
+     * @param 	options How the new stage's thread is set up
+     */
+    template <typename F>
+    Spawn<ForEach<F>> for_each(F f, Stage::Options options) {
+        return {{std::move(f)}, std::move(options)};
+    }
+
+    /**
+     * @brief 	Appends an operator, fusing it into the current stage
+     */
+    template <typename Rx, typename Chain, typename Op>
+        requires is_operator<Op>
+    auto operator|(Flow<Rx, Chain>&& flow, Op op) {
+        return std::move(flow).then(std::move(op));
+    }
+
+    /**
+     * @brief 	Appends an operator or sink in a new stage; a stage with
+     * 			no operators yet is reused instead
+     */
+    template <typename Rx, typename Chain, typename Op>
+    auto operator|(Flow<Rx, Chain>&& flow, Spawn<Op> spawn) {
+        if constexpr (std::is_same_v<Chain, internal::Identity>)
+            return std::move(flow).with(std::move(spawn.options)) |
+                   std::move(spawn.op);
+        else
+            return std::move(flow).spawn(std::move(spawn.options)) |
+                   std::move(spawn.op);
+    }
+
+    /**
+     * @brief 	Appends a parallel map, which runs in stages of its own
+     */
+    template <typename Rx, typename Chain, typename F>
+    auto operator|(Flow<Rx, Chain>&& flow, ParallelMap<F> op) {
+        return std::move(flow).parallel(std::move(op));
+    }
+
+    /**
+     * @brief 	Appends a batching operator, which starts a new stage
+     */
+    template <typename Rx, typename Chain>
+    auto operator|(Flow<Rx, Chain>&& flow, Batch op) {
+        return std::move(flow).batched(std::move(op));
+    }
+
+    /**
+     * @brief 	Appends a windowing operator, which starts a new stage
+     */
+    template <typename Rx, typename Chain, typename R, typename Time>
+    auto operator|(Flow<Rx, Chain>&& flow, Windowed<R, Time> op) {
+        return std::move(flow).windowed(std::move(op));
+    }
+
+    /**
+     * @brief 	Ends a flow in a function called with each item
+     */
+    template <typename Rx, typename Chain, typename F>
+    Pipeline operator|(Flow<Rx, Chain>&& flow, ForEach<F> sink) {
+        return std::move(flow).finish(std::move(sink.f));
+    }
+
+    /**
+     * @brief 	Ends a flow in a Sender, which the pipeline owns
+     * @note 	Items produced after the Sender's receiver expires are
+     * 			dropped.
+     */
+    template <typename Rx, typename Chain, typename Tx>
+        requires requires(Tx& tx, typename Flow<Rx, Chain>::Out item) {
+            tx.send(std::move(item));
+        }
+    Pipeline operator|(Flow<Rx, Chain>&& flow, Tx tx) {
+        return std::move(flow).finish(
+            [tx = std::move(tx)](auto&& item) mutable {
+                try {
+                    tx.send(std::forward<decltype(item)>(item));
+                } catch (const std::runtime_error&) {
+                    throw internal::Expired();
+                }
+            });
+    }
+
+    /**
+     * @brief 	Starts a flow from a source, such as a Receiver, which
+     * 			the pipeline owns
+     */
+    template <typename Rx, typename Next>
+        requires internal::Source<Rx>
+    auto operator|(Rx rx, Next next)
+        -> decltype(Flow<Rx>(std::move(rx)) | std::move(next)) {
+        return Flow<Rx>(std::move(rx)) | std::move(next);
+    }
+
+    template <typename Rx, typename Chain>
+    template <typename Sink>
+    Stage Flow<Rx, Chain>::start(Sink sink) && {
+        return Stage(
+            std::move(rx),
+            [chain = std::move(chain),
+             sink = std::move(sink)](In item) mutable {
+                chain(std::move(item), sink);
+            },
+            std::move(options));
+    }
+
+    template <typename Rx, typename Chain>
+    Flow<internal::LinkReceiver<typename Flow<Rx, Chain>::Out>>
+    Flow<Rx, Chain>::spawn(Stage::Options next) && {
+        auto link = std::make_shared<internal::Link<Out>>(capacity);
+        internal::LinkReceiver<Out> output(link);
+
+        auto stages = std::move(this->stages);
+        stages.push_back(std::move(*this).start(
+            [tx = internal::LinkSender<Out>(link)](auto&& item) mutable {
+                try {
+                    tx.send(std::forward<decltype(item)>(item));
+                } catch (const std::runtime_error&) {
+                    throw internal::Expired();
+                }
+            }));
+        return Flow<internal::LinkReceiver<Out>>(
+            std::move(output), {}, std::move(next), std::move(stages),
+            std::move(failures));
+    }
+
+    template <typename Rx, typename Chain>
+    template <typename F>
+    Flow<internal::ReorderReceiver<std::remove_cvref_t<
+        std::invoke_result_t<F&, typename Flow<Rx, Chain>::Out>>>>
+    Flow<Rx, Chain>::parallel(ParallelMap<F> op) && {
+        using Result = std::remove_cvref_t<std::invoke_result_t<F&, Out>>;
+        using Tagged = std::pair<std::uint64_t, Out>;
+
+        auto work = std::make_shared<internal::Link<Tagged>>(op.window);
+        auto reorder = std::make_shared<internal::Reorder<Result>>(op.window);
+        internal::SharedLinkReceiver<Tagged> input(work);
+        internal::ReorderWriter<Result> output(reorder);
+
+        // Tag items in the current stage, which fuses with the operators
+        // before this one
+        auto stages = std::move(this->stages);
+        stages.push_back(std::move(*this).start(
+            [tx = internal::LinkSender<Tagged>(work),
+             sequence = std::uint64_t(0)](auto&& item) mutable {
+                try {
+                    tx.send(Tagged(sequence++,
+                                   std::forward<decltype(item)>(item)));
+                } catch (const std::runtime_error&) {
+                    throw internal::Expired();
+                }
+            }));
+
+        // A failed item leaves a hole, so later items still flow, and
+        // its worker records the exception and carries on
+        auto f = std::make_shared<F>(std::move(op.f));
+        auto failure = std::make_shared<internal::Failure>();
+        for (std::size_t i = 0; i < op.workers; i++) {
+            auto options = op.options;
+            if (!options.name.empty())
+                options.name += "-" + std::to_string(i);
+
+            stages.emplace_back(
+                input,
+                [f, output, failure](Tagged tagged) mutable {
+                    std::optional<Result> result;
+                    try {
+                        result = (*f)(std::move(tagged.second));
+                    } catch (...) {
+                        failure->record(std::current_exception());
+                    }
+                    output.put(tagged.first, std::move(result));
+                },
+                std::move(options));
+        }
+
+        auto failures = std::move(this->failures);
+        failures.push_back(std::move(failure));
+        return Flow<internal::ReorderReceiver<Result>>(
+            internal::ReorderReceiver<Result>(std::move(reorder)), {}, {},
+            std::move(stages), std::move(failures));
+    }
+
+    template <typename Rx, typename Chain>
+    auto Flow<Rx, Chain>::batched(Batch op) && {
+        // The batcher reads a link, which its upstream stage closes when
+        // stopped, so that stopping hands out the pending batch
+        auto next = std::move(*this).spawn(std::move(op.options));
+        using Link = internal::LinkReceiver<Out>;
+        return Flow<Batcher<Link>>(
+            Batcher<Link>(std::move(next.rx), op.max_items, op.max_delay,
+                          op.adaptive),
+            {}, std::move(next.options), std::move(next.stages),
+            std::move(next.failures));
+    }
+
+    template <typename Rx, typename Chain>
+    template <typename R, typename Time>
+    auto Flow<Rx, Chain>::windowed(Windowed<R, Time> op) && {
+        // As with batching, the windower reads a link its upstream
+        // stage closes, so that stopping flushes the open windows
+        auto next = std::move(*this).spawn(std::move(op.options));
+        using Link = internal::LinkReceiver<Out>;
+        return Flow<Windower<Link, R, Time>>(
+            Windower<Link, R, Time>(std::move(next.rx), op.shape,
+                                    std::move(op.reducer),
+                                    std::move(op.time)),
+            {}, std::move(next.options), std::move(next.stages),
+            std::move(next.failures));
+    }
+
+    template <typename Rx, typename Chain>
+    template <typename F>
+    Pipeline Flow<Rx, Chain>::finish(F sink) && {
+        auto stages = std::move(this->stages);
+        auto failures = std::move(this->failures);
+        stages.push_back(std::move(*this).start(std::move(sink)));
+        return Pipeline(std::move(stages), std::move(failures));
+    }
+
+    inline Pipeline::~Pipeline() {
+        if (stages.empty() || !stages.front().joinable())
+            return;
+        stop();
+        for (auto& stage : stages) {
+            try {
+                if (stage.joinable())
+                    stage.join();
+            } catch (...) {
+            }
+        }
+    }
+
+    inline void Pipeline::stop() {
+        if (!stages.empty())
+            stages.front().stop();
+    }
+
+    inline void Pipeline::join() {
+        // Join from the sink back, so that a failed stage can stop the
+        // source instead of leaving the stages before it waiting
+        std::vector<std::exception_ptr> errors(stages.size());
+        for (auto i = stages.size(); i-- > 0;) {
+            try {
+                if (stages[i].joinable())
+                    stages[i].join();
+            } catch (...) {
+                errors[i] = std::current_exception();
+                stop();
+            }
+        }
+
+        std::exception_ptr error;
+        for (auto& e : errors)
+            if (!error)
+                error = e;
+        for (auto& failure : failures)
+            if (!error)
+                error = failure->get();
+        if (error)
+            std::rethrow_exception(error);
+    }
+} // namespace piper
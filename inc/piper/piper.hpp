@@ -31,7 +31,11 @@
  *  @date	 	2022-04-19
  */
 
+#pragma once
+
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <utility>
 
 /**
@@ -61,6 +65,20 @@ namespace piper {
              */
             virtual T recv() = 0;
 
+            /**
+             * @brief 	Receives an item from the channel, if one is
+             * 			available
+             * @return 	The item received over the channel, or
+             * 			std::nullopt if the channel is empty
+             * @throws 	std::logic_error Thrown by default, for receivers
+             * 			that cannot poll
+             * @note 	Implementors of this interface will not block on
+             * 			this method, but may throw exceptions.
+             */
+            virtual std::optional<T> try_recv() {
+                throw std::logic_error("receiver cannot be polled");
+            }
+
             /**
              * @brief	Copies item from channel
              * @param 	item The output of the Receiver
@@ -172,6 +190,7 @@ namespace piper {
 
     template <typename T> Sender<T>& Sender<T>::operator<<(Receiver<T>& rx) {
         send(std::forward<T>(rx.recv()));
+        return *this;
     }
 
 } // namespace piper
@@ -0,0 +1,157 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		pool.hpp
+ * @brief 		Bounded object pool with recycling handles
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "piper/internal/freelist.hpp"
+
+namespace piper {
+    /**
+     * @class 	Pool
+     * @brief 	A bounded pool of reusable items
+     * @details Items are handed out as Handles, which return the item to
+     * 			the pool when destroyed. Sending a Handle over a channel
+     * 			moves ownership to the receiver, so the consumer releasing
+     * 			the item recycles it for the producer without freeing it.
+     * 			The free list is lock-free, and Pool copies share the same
+     * 			storage.
+     * @tparam 	T The type of item stored in the pool
+     * @note 	Recycled items are not reset; clear them after acquire()
+     * 			if their previous contents matter.
+     */
+    template <typename T> class Pool {
+            /// Shared pool storage, kept alive by outstanding Handles
+            struct Storage {
+                    std::unique_ptr<T[]> items;
+                    internal::FreeList free;
+
+                    Storage(std::size_t n)
+                        : items(new T[n]), free(static_cast<std::uint32_t>(n)) {}
+            };
+
+            std::shared_ptr<Storage> storage;
+
+        public:
+            /**
+             * @class 	Recycler
+             * @brief 	Handle deleter that returns items to the pool
+             */
+            class Recycler {
+                    std::shared_ptr<Storage> storage;
+
+                public:
+                    /// Constructs a Recycler for items not owned by a pool
+                    Recycler() = default;
+
+                    /**
+                     * @brief 	Constructs a Recycler for pooled items
+                     * @param 	storage The storage owning the items
+                     */
+                    Recycler(std::shared_ptr<Storage> storage)
+                        : storage(std::move(storage)) {}
+
+                    /**
+                     * @brief 	Releases an item
+                     * @param 	item The item being released
+                     * @note 	Pooled items are pushed back onto the free
+                     * 			list, all others are deleted.
+                     */
+                    void operator()(T* item) const;
+            };
+
+            /// An owning handle to an item acquired from the pool
+            using Handle = std::unique_ptr<T, Recycler>;
+
+            /**
+             * @brief 	Constructs a pool
+             * @param 	n The number of items preallocated by the pool
+             */
+            explicit Pool(std::size_t n)
+                : storage(std::make_shared<Storage>(n)) {}
+
+            /**
+             * @brief 	Copies a Pool
+             * @param 	pool The Pool to copy
+             * @note 	Both pools share the same storage
+             */
+            Pool(const Pool<T>& pool) = default;
+
+            /**
+             * @brief 	Moves a Pool
+             * @param 	pool The Pool to move
+             */
+            Pool(Pool<T>&& pool) = default;
+
+            Pool() = delete;
+
+            /**
+             * @brief 	Acquires an item from the pool
+             * @return 	A Handle to the item
+             * @note 	If the pool is exhausted, a new item is allocated
+             * 			and deleted on release instead of being recycled.
+             */
+            Handle acquire();
+
+            /**
+             * @brief 	Acquires an item from the pool without allocating
+             * @return 	A Handle to the item, or an empty Handle if the
+             * 			pool is exhausted
+             */
+            Handle try_acquire();
+    };
+
+    template <typename T> void Pool<T>::Recycler::operator()(T* item) const {
+        if (storage) {
+            storage->free.push(
+                static_cast<std::uint32_t>(item - storage->items.get()));
+        } else {
+            delete item;
+        }
+    }
+
+    template <typename T> typename Pool<T>::Handle Pool<T>::acquire() {
+        if (auto item = try_acquire())
+            return item;
+        return Handle(new T(), Recycler());
+    }
+
+    template <typename T> typename Pool<T>::Handle Pool<T>::try_acquire() {
+        if (auto i = storage->free.pop())
+            return Handle(&storage->items[*i], Recycler(storage));
+        return Handle(nullptr, Recycler());
+    }
+} // namespace piper
@@ -0,0 +1,294 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		rate.hpp
+ * @brief 		Token-bucket rate limiting
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <cerrno>
+#include <time.h>
+#endif
+
+#include "piper/piper.hpp"
+
+namespace piper::internal {
+    /// Reads the monotonic clock, in nanoseconds
+    inline std::int64_t monotonic() {
+#ifdef __linux__
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return std::int64_t(now.tv_sec) * 1'000'000'000 + now.tv_nsec;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+    }
+
+    /**
+     * @brief 	Sleeps until the monotonic clock reaches a deadline
+     * @param 	deadline The deadline, in nanoseconds
+     * @note 	On Linux this is an absolute clock_nanosleep(), which
+     * 			neither drifts when interrupted nor oversleeps by the
+     * 			time taken to compute a relative delay.
+     */
+    inline void sleep_until(std::int64_t deadline) {
+#ifdef __linux__
+        timespec until{time_t(deadline / 1'000'000'000),
+                       long(deadline % 1'000'000'000)};
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &until,
+                               nullptr) == EINTR) {
+        }
+#else
+        std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::nanoseconds(deadline))));
+#endif
+    }
+} // namespace piper::internal
+
+namespace piper {
+    /**
+     * @class 	TokenBucket
+     * @brief 	A lock-free token bucket, shared by the senders or stages
+     * 			it limits
+     * @details Tokens refill at a fixed rate, and up to burst of them
+     * 			accumulate while the bucket is idle. The bucket is a
+     * 			single atomic: the time at which every token handed out
+     * 			so far will have been earned. Taking several tokens is
+     * 			one compare-and-swap, so callers that take a batch at a
+     * 			time rarely contend on it.
+     */
+    class TokenBucket {
+            /// Nanoseconds per token, and per full bucket
+            std::int64_t interval;
+            std::int64_t depth;
+            std::size_t capacity;
+
+            alignas(64) std::atomic<std::int64_t> earned{0};
+
+            /**
+             * @brief 	Takes tokens from the bucket
+             * @param 	max The most tokens to take
+             * @param 	wait Whether to reserve max tokens when none are
+             * 			available, rather than take none
+             * @return 	The number of tokens taken, and when the last of
+             * 			them is earned
+             */
+            std::pair<std::size_t, std::int64_t> take(std::size_t max,
+                                                      bool wait);
+
+        public:
+            /**
+             * @brief 	Constructs a full TokenBucket
+             * @param 	rate The number of tokens earned per second
+             * @param 	burst The most tokens the bucket holds, at least 1
+             * @throws 	std::logic_error Thrown if rate is not positive
+             */
+            explicit TokenBucket(double rate, std::size_t burst = 1);
+
+            TokenBucket(const TokenBucket&) = delete;
+
+            /**
+             * @brief 	Takes at least one and at most max tokens
+             * @param 	max The most tokens to take, capped at burst
+             * @return 	The number of tokens taken
+             * @note 	Takes every available token up to max without
+             * 			waiting. If none are available, sleeps until max
+             * 			tokens have been earned, so a batch of tokens
+             * 			costs one wakeup.
+             */
+            std::size_t acquire(std::size_t max = 1);
+
+            /**
+             * @brief 	Takes up to max tokens, if any are available
+             * @param 	max The most tokens to take, capped at burst
+             * @return 	The number of tokens taken, possibly 0
+             */
+            std::size_t try_acquire(std::size_t max = 1);
+
+            /// Gets the number of tokens earned per second
+            double rate() const { return 1e9 / double(interval); }
+
+            /// Gets the most tokens the bucket holds
+            std::size_t burst() const { return capacity; }
+    };
+
+    inline TokenBucket::TokenBucket(double rate, std::size_t burst)
+        : capacity(std::max<std::size_t>(burst, 1)) {
+        if (!(rate > 0))
+            throw std::logic_error("rate is not positive");
+        interval = std::max<std::int64_t>(std::llround(1e9 / rate), 1);
+        depth = interval * std::int64_t(capacity);
+    }
+
+    inline std::pair<std::size_t, std::int64_t>
+    TokenBucket::take(std::size_t max, bool wait) {
+        max = std::clamp<std::size_t>(max, 1, capacity);
+        auto now = internal::monotonic();
+        auto last = earned.load(std::memory_order_relaxed);
+        std::size_t taken;
+        std::int64_t next;
+        do {
+            // An idle bucket holds at most burst tokens
+            auto from = std::max(last, now - depth);
+            auto available = (now - from) / interval;
+            if (available > 0)
+                taken = std::min<std::size_t>(available, max);
+            else if (wait)
+                taken = max;
+            else
+                return {0, now};
+            next = from + std::int64_t(taken) * interval;
+        } while (!earned.compare_exchange_weak(last, next,
+                                               std::memory_order_relaxed));
+        return {taken, next};
+    }
+
+    inline std::size_t TokenBucket::acquire(std::size_t max) {
+        auto [taken, deadline] = take(max, true);
+        if (deadline > internal::monotonic())
+            internal::sleep_until(deadline);
+        return taken;
+    }
+
+    inline std::size_t TokenBucket::try_acquire(std::size_t max) {
+        return take(max, false).first;
+    }
+} // namespace piper
+
+namespace piper::internal {
+    /**
+     * @class 	Allowance
+     * @brief 	Tokens taken from a shared bucket a batch at a time, and
+     * 			spent one at a time by a single thread
+     */
+    class Allowance {
+            std::shared_ptr<TokenBucket> bucket;
+            std::size_t batch;
+            std::size_t left = 0;
+
+        public:
+            Allowance(std::shared_ptr<TokenBucket> bucket,
+                      std::size_t batch)
+                : bucket(std::move(bucket)),
+                  batch(std::max<std::size_t>(batch, 1)) {}
+
+            /// Spends a token, waiting for the bucket if none are left
+            void spend() {
+                if (left == 0)
+                    left = bucket->acquire(batch);
+                left--;
+            }
+    };
+} // namespace piper::internal
+
+namespace piper {
+    /**
+     * @class 	RateLimitedSender
+     * @brief 	A Sender that waits for a token before each send
+     * @details Wraps another Sender, which it owns. Several senders
+     * 			sharing one TokenBucket are limited together. Each takes
+     * 			tokens from the bucket in batches, which keeps the
+     * 			bucket uncontended and wakes a throttled sender once per
+     * 			batch, at the cost of sending each batch back to back.
+     * @tparam 	T The type of item sent
+     * @note 	A RateLimitedSender is not thread-safe; give each thread
+     * 			its own, sharing the bucket.
+     */
+    template <typename T> class RateLimitedSender final : public Sender<T> {
+            std::unique_ptr<Sender<T>> tx;
+            internal::Allowance allowance;
+
+        public:
+            /**
+             * @brief 	Constructs a RateLimitedSender with a bucket of
+             * 			its own
+             * @param 	tx The wrapped sender
+             * @param 	rate The most items sent per second
+             * @param 	burst The most items sent back to back after an
+             * 			idle period
+             */
+            template <typename Tx>
+                requires std::derived_from<Tx, Sender<T>>
+            RateLimitedSender(Tx tx, double rate, std::size_t burst = 1)
+                : RateLimitedSender(
+                      std::move(tx),
+                      std::make_shared<TokenBucket>(rate, burst)) {}
+
+            /**
+             * @brief 	Constructs a RateLimitedSender with a shared bucket
+             * @param 	tx The wrapped sender
+             * @param 	bucket The bucket shared by every limited sender
+             * @param 	batch The number of tokens taken at a time
+             */
+            template <typename Tx>
+                requires std::derived_from<Tx, Sender<T>>
+            RateLimitedSender(Tx tx, std::shared_ptr<TokenBucket> bucket,
+                              std::size_t batch = 1)
+                : tx(std::make_unique<Tx>(std::move(tx))),
+                  allowance(std::move(bucket), batch) {}
+
+            RateLimitedSender(RateLimitedSender<T>&&) = default;
+            RateLimitedSender(const RateLimitedSender<T>&) = delete;
+
+            /**
+             * @brief 	Sends an item, once a token is available
+             * @param 	item The item being sent
+             */
+            void send(const T& item) override {
+                allowance.spend();
+                tx->send(item);
+            }
+
+            /**
+             * @brief 	Sends an item, once a token is available
+             * @param 	item The item being sent
+             */
+            void send(T&& item) override {
+                allowance.spend();
+                tx->send(std::move(item));
+            }
+    };
+} // namespace piper
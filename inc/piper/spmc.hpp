@@ -32,7 +32,10 @@
  * @date 		2022-04-19
  */
 
+#pragma once
+
 #include <stdexcept>
+#include <type_traits>
 
 #include "piper/internal/buffer.hpp"
 #include "piper/piper.hpp"
@@ -63,8 +66,10 @@ namespace piper::spmc {
             /**
              * @brief Copies a Receiver from a Sender
              * @param tx The Sender from which Receiver is copied
+             * @note  Stealing buffers give each Receiver its own lane
              */
-            Receiver(const Sender<T>& tx) : buffer{tx.buffer} {}
+            Receiver(const Sender<T>& tx)
+                : buffer{tx.buffer->attach(tx.buffer)} {}
 
             /**
              * @brief Copies a Receiver from a Channel
@@ -75,8 +80,9 @@ namespace piper::spmc {
             /**
              * @brief Copies a Receiver
              * @param rx The Receiver to copy
+             * @note  Stealing buffers give each Receiver its own lane
              */
-            Receiver(const Receiver<T>& rx) = default;
+            Receiver(const Receiver<T>& rx);
 
             /**
              * @brief Moves a Receiver
@@ -86,6 +92,14 @@ namespace piper::spmc {
 
             Receiver() = delete;
 
+            /**
+             * @brief Destructs a Receiver, releasing its lane if any
+             */
+            ~Receiver() {
+                if (auto buffer = this->buffer.lock())
+                    buffer->detach();
+            }
+
             /**
              * @brief 	Receive an item over the channel
              * @return 	The item received over the channel
@@ -94,6 +108,32 @@ namespace piper::spmc {
              * @note 	Blocks on empty buffer
              */
             T recv() noexcept(false) override;
+
+            /**
+             * @brief 	Receives an item from the channel, if one is
+             * 			available
+             * @return 	The item received over the channel, or
+             * 			std::nullopt if the buffer is empty
+             * @throws 	std::runtime_error Thrown if the sender
+             * 			no longer exists.
+             */
+            std::optional<T> try_recv() noexcept(false) override;
+
+            /**
+             * @brief 	Attaches a readiness listener to the channel
+             * @param 	listener The listener, e.g. a piper::Notifier,
+             * 			or nullptr to detach
+             * @throws 	std::runtime_error Thrown if the sender
+             * 			no longer exists.
+             */
+            void listen(std::shared_ptr<piper::internal::Listener> listener);
+
+            /**
+             * @brief 	Gets the number of items dropped on overflow
+             * @return 	The number of items discarded by the buffer,
+             * 			or zero if the buffer has expired
+             */
+            std::size_t dropped() const;
     };
 
     /**
@@ -122,6 +162,14 @@ namespace piper::spmc {
              */
             Sender(std::size_t n);
 
+            /**
+             * @brief 	Constructs a Sender over an existing buffer
+             * @param 	buffer The channel buffer, of any flavor
+             */
+            explicit Sender(
+                std::shared_ptr<piper::internal::Buffer<T>> buffer)
+                : buffer(std::move(buffer)) {}
+
             /**
              * @brief	Moves a Sender
              * @param 	tx The Sender to move
@@ -132,13 +180,15 @@ namespace piper::spmc {
              * @brief 	Moves a Sender from a Channel
              * @param   ch The Channel from which Sender is moved
              */
-            Sender(Channel<T>&& ch) : Sender(std::forward<Sender<T>>(ch.tx)) {}
+            Sender(Channel<T>&& ch) : Sender(std::move(ch.tx)) {}
 
             Sender(const Sender<T>&) = delete;
 
             /**
              * @brief 	Copies and sends an item over the channel
              * @param 	item The item being sent over the channel
+             * @throws 	std::logic_error Thrown if T is not copy
+             * 			constructible
              * @note  	May block if using a synchronous buffer
              */
             void send(const T& item) override;
@@ -149,6 +199,12 @@ namespace piper::spmc {
              * @note  	May block if using a synchronous buffer
              */
             void send(T&& item) override;
+
+            /**
+             * @brief 	Gets the number of items dropped on overflow
+             * @return 	The number of items discarded by the buffer
+             */
+            std::size_t dropped() const { return buffer->dropped(); }
     };
 
     /**
@@ -162,10 +218,10 @@ namespace piper::spmc {
             friend class Receiver<T>;
 
             /// The Sender component
-            std::unique_ptr<Sender<T>> tx;
+            Sender<T> tx;
 
             /// The Receiver component
-            std::unique_ptr<Receiver<T>> rx;
+            Receiver<T> rx;
 
         public:
             /// Constructs an asynchronous Channel
@@ -178,6 +234,13 @@ namespace piper::spmc {
              */
             Channel(std::size_t n) : tx(n), rx(this->tx) {}
 
+            /**
+             * @brief 	Constructs a Channel over an existing buffer
+             * @param 	buffer The channel buffer, of any flavor
+             */
+            explicit Channel(std::shared_ptr<piper::internal::Buffer<T>> buffer)
+                : tx(std::move(buffer)), rx(this->tx) {}
+
             /**
              * @brief	Moves a Channel
              * @param 	ch The Channel to move
@@ -195,9 +258,19 @@ namespace piper::spmc {
              */
             T recv() override;
 
+            /**
+             * @brief 	Receives an item from the channel, if one is
+             * 			available
+             * @return 	The item received over the channel, or
+             * 			std::nullopt if the buffer is empty
+             */
+            std::optional<T> try_recv() override { return rx.try_recv(); }
+
             /**
              * @brief 	Copies and sends an item over the channel
              * @param 	item The item being sent over the channel
+             * @throws 	std::logic_error Thrown if T is not copy
+             * 			constructible
              * @note  	May block if using a synchronous buffer
              */
             void send(const T& item) override;
@@ -210,41 +283,91 @@ namespace piper::spmc {
             void send(T&& item) override;
     };
 
+    /**
+     * @struct 	Topology
+     * @brief 	Selects SPMC endpoints in piper::make_channel
+     */
+    struct Topology {
+            template <typename T> using Sender = spmc::Sender<T>;
+            template <typename T> using Receiver = spmc::Receiver<T>;
+
+            /**
+             * @brief 	Connects a Sender and Receiver over a buffer
+             * @param 	buffer The channel buffer, owned by the Sender
+             * @return 	The connected Sender and Receiver
+             */
+            template <typename T>
+            static std::pair<Sender<T>, Receiver<T>>
+            connect(std::shared_ptr<piper::internal::Buffer<T>> buffer) {
+                Sender<T> tx(std::move(buffer));
+                Receiver<T> rx(tx);
+                return {std::move(tx), std::move(rx)};
+            }
+    };
+
+    template <typename T> Receiver<T>::Receiver(const Receiver<T>& rx) {
+        if (auto buffer = rx.buffer.lock())
+            this->buffer = buffer->attach(buffer);
+    }
+
     template <typename T> T Receiver<T>::recv() {
         if (buffer.expired())
             throw std::runtime_error("sender is expired");
         return buffer.lock()->pop();
     }
 
+    template <typename T> std::optional<T> Receiver<T>::try_recv() {
+        if (buffer.expired())
+            throw std::runtime_error("sender is expired");
+        return buffer.lock()->try_pop();
+    }
+
+    template <typename T>
+    void Receiver<T>::listen(
+        std::shared_ptr<piper::internal::Listener> listener) {
+        if (buffer.expired())
+            throw std::runtime_error("sender is expired");
+        buffer.lock()->listen(std::move(listener));
+    }
+
+    template <typename T> std::size_t Receiver<T>::dropped() const {
+        auto buffer = this->buffer.lock();
+        return buffer ? buffer->dropped() : 0;
+    }
+
     template <typename T> Sender<T>::Sender() {
         using namespace piper::internal;
-        buffer.reset(new AsyncBuffer<T>{});
+        buffer = std::make_shared<AsyncBuffer<T>>();
     }
 
     template <typename T> Sender<T>::Sender(std::size_t n) {
         using namespace piper::internal;
         if (n > 0) {
-            buffer.reset(new SyncBuffer<T>{n});
+            buffer = std::make_shared<SyncBuffer<T>>(n);
         } else {
-            buffer.reset(new RendezvousBuffer<T>{});
+            buffer = std::make_shared<RendezvousBuffer<T>>();
         }
     }
 
     template <typename T> void Sender<T>::send(const T& item) {
-        buffer->push(item);
+        if constexpr (std::is_copy_constructible_v<T>) {
+            buffer->push(item);
+        } else {
+            throw std::logic_error("item is not copy constructible");
+        }
     }
 
     template <typename T> void Sender<T>::send(T&& item) {
         buffer->push(std::forward<T>(item));
     }
 
-    template <typename T> T Channel<T>::recv() { return rx->recv(); }
+    template <typename T> T Channel<T>::recv() { return rx.recv(); }
 
     template <typename T> void Channel<T>::send(const T& item) {
-        tx->send(item);
+        tx.send(item);
     }
 
     template <typename T> void Channel<T>::send(T&& item) {
-        tx->send(std::forward<T>(item));
+        tx.send(std::forward<T>(item));
     }
 } // namespace piper::spmc
@@ -0,0 +1,436 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		stage.hpp
+ * @brief 		Pipeline stages running on dedicated threads
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "piper/internal/buffer.hpp"
+
+namespace piper::internal {
+    /// Whether F can be applied to the items received by Rx
+    template <typename Rx, typename F>
+    concept Consumes =
+        std::is_invocable_v<F&, decltype(std::declval<Rx&>().recv())>;
+
+    /// Whether T is a std::optional
+    template <typename T> inline constexpr bool is_optional = false;
+    template <typename T>
+    inline constexpr bool is_optional<std::optional<T>> = true;
+
+    /**
+     * @struct 	Expired
+     * @brief 	Thrown by a consuming stage's function to end the stage
+     * 			without an error, once its downstream has expired
+     */
+    struct Expired final {};
+} // namespace piper::internal
+
+namespace piper {
+    /**
+     * @class 	Stage
+     * @brief 	A thread that moves items from a Receiver, through a
+     * 			function, into a Sender
+     * @details The stage owns its endpoints and its thread. It runs
+     * 			until stop() is called, or until receiving or sending
+     * 			throws std::runtime_error, which is how channels
+     * 			report an expired peer. Receivers that accept a
+     * 			listener are polled with try_recv() and waited on
+     * 			through the listener, so a stage notices a stop
+     * 			request or a destroyed upstream buffer while idle,
+     * 			and are also woken at their due() time, if any, as a
+     * 			Batcher or Windower has; other receivers, and those
+     * 			whose buffer cannot notify, are blocked on with
+     * 			recv(). The
+     * 			thread can be pinned to CPUs, named for profilers and
+     * 			debuggers, and given a real-time priority before it
+     * 			receives anything.
+     * @note 	A function returning std::optional sends only engaged
+     * 			results, so a stage can also filter.
+     * @warning The stage replaces any listener on its receiver.
+     */
+    class Stage {
+        public:
+            /// How the stage's thread is set up
+            struct Options {
+                    /// The thread name, truncated to 15 characters
+                    std::string name{};
+
+                    /// The CPUs the thread may run on, or all if empty
+                    std::vector<int> cpus{};
+
+                    /// A SCHED_FIFO priority from 1 to 99, or 0 to keep
+                    /// the default scheduler
+                    int priority = 0;
+            };
+
+        private:
+            /// State shared by the stage and its thread
+            struct State {
+                    /// Bumped whenever the thread should look again
+                    std::atomic<std::uint32_t> word{0};
+                    std::atomic<bool> stopping{false};
+
+                    /// The exception that ended the stage, if any
+                    std::exception_ptr error;
+
+                    /// Whether the thread waits through a listener,
+                    /// rather than blocking in recv()
+                    bool listening = false;
+
+                    /// Waited on instead of word until a due time
+                    std::mutex mutex;
+                    std::condition_variable changed;
+
+                    void wake() {
+                        word.fetch_add(1);
+                        word.notify_all();
+                        {
+                            // Order the bump before a timed waiter's check
+                            auto lock = std::lock_guard(mutex);
+                        }
+                        changed.notify_all();
+                    }
+            };
+
+            /// Wakes the thread when its buffer fills or is destroyed
+            struct Waker final : internal::Listener {
+                    std::shared_ptr<State> state;
+                    explicit Waker(std::shared_ptr<State> state)
+                        : state(std::move(state)) {}
+                    ~Waker() { state->wake(); }
+                    void filled() override { state->wake(); }
+                    void drained() override {}
+            };
+
+            std::thread thread;
+            std::shared_ptr<State> state = std::make_shared<State>();
+
+            /// Applies options to the calling thread
+            static void apply(const Options& options);
+
+            /// Starts the thread, once it has applied options
+            template <typename Body> void start(Body body, Options options);
+
+            /**
+             * @brief 	Attaches a Waker to rx
+             * @return 	false if rx is expired
+             * @note 	A buffer that cannot notify listeners throws
+             * 			std::logic_error, and is blocked on instead.
+             */
+            template <typename Rx>
+            static bool listen(Rx& rx, const std::shared_ptr<State>& state);
+
+            /// Receives an item, or std::nullopt once the stage ends
+            template <typename Rx> static auto receive(Rx& rx, State& state);
+
+            /// Sends an item, returning false once the downstream expires
+            template <typename Tx, typename U>
+            static bool send(Tx& tx, U&& item);
+
+        public:
+            /**
+             * @brief 	Constructs a Stage that forwards results
+             * @param 	rx The Receiver the stage takes items from
+             * @param 	tx The Sender the stage sends results into
+             * @param 	f The function applied to each item
+             * @param 	options How the stage's thread is set up
+             * @throws 	std::system_error Thrown if the options cannot be
+             * 			applied, e.g. SCHED_FIFO without privileges
+             */
+            template <typename Rx, typename Tx, typename F>
+                requires internal::Consumes<Rx, F>
+            Stage(Rx rx, Tx tx, F f, Options options = {});
+
+            /**
+             * @brief 	Constructs a Stage that consumes items
+             * @param 	rx The Receiver the stage takes items from
+             * @param 	f The function applied to each item
+             * @param 	options How the stage's thread is set up
+             * @throws 	std::system_error Thrown if the options cannot be
+             * 			applied
+             * @note 	The stage ends without an error when f throws
+             * 			internal::Expired.
+             */
+            template <typename Rx, typename F>
+                requires internal::Consumes<Rx, F>
+            Stage(Rx rx, F f, Options options = {});
+
+            /// Moves a Stage, leaving the source stopped and joined
+            Stage(Stage&& stage)
+                : thread(std::move(stage.thread)),
+                  state(std::exchange(stage.state,
+                                      std::make_shared<State>())) {}
+            Stage(const Stage&) = delete;
+
+            Stage& operator=(Stage&& stage);
+            Stage& operator=(const Stage&) = delete;
+
+            /**
+             * @brief 	Destructs a Stage, stopping it and waiting for it
+             * @note 	Any exception thrown by the function is discarded;
+             * 			call join() to observe it.
+             * @warning As with stop(), a stage blocked in recv() or
+             * 			send() ends only once that call returns.
+             */
+            ~Stage();
+
+            /**
+             * @brief 	Asks the stage to finish after its current item
+             * @note 	Items still queued in the receiver stay there.
+             * @warning A stage blocked in recv(), on a receiver that
+             * 			cannot notify a listener, or in send(), on a
+             * 			full channel, only notices the request once that
+             * 			call returns, so expire its endpoints to end it.
+             */
+            void stop();
+
+            /**
+             * @brief 	Waits for the stage to finish
+             * @throws 	Any exception thrown by the stage's function
+             */
+            void join();
+
+            /// Checks whether the stage has not been joined
+            bool joinable() const { return thread.joinable(); }
+
+            /// Gets the native handle of the stage's thread
+            std::thread::native_handle_type native_handle() {
+                return thread.native_handle();
+            }
+    };
+
+    inline void Stage::apply(const Options& options) {
+#ifdef __linux__
+        auto self = pthread_self();
+        if (!options.name.empty()) {
+            auto name = options.name.substr(0, 15);
+            if (int error = pthread_setname_np(self, name.c_str()))
+                throw std::system_error(error, std::generic_category(),
+                                        "pthread_setname_np");
+        }
+        if (!options.cpus.empty()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu : options.cpus) {
+                if (cpu < 0 || cpu >= CPU_SETSIZE)
+                    throw std::invalid_argument("invalid cpu");
+                CPU_SET(cpu, &set);
+            }
+            if (int error = pthread_setaffinity_np(self, sizeof(set), &set))
+                throw std::system_error(error, std::generic_category(),
+                                        "pthread_setaffinity_np");
+        }
+        if (options.priority > 0) {
+            sched_param param{};
+            param.sched_priority = options.priority;
+            if (int error = pthread_setschedparam(self, SCHED_FIFO, &param))
+                throw std::system_error(error, std::generic_category(),
+                                        "pthread_setschedparam");
+        }
+#else
+        (void)options;
+#endif
+    }
+
+    template <typename Body> void Stage::start(Body body, Options options) {
+        std::promise<void> ready;
+        auto started = ready.get_future();
+
+        thread = std::thread([body = std::move(body),
+                              options = std::move(options),
+                              ready = std::move(ready),
+                              state = state]() mutable {
+            try {
+                apply(options);
+            } catch (...) {
+                ready.set_exception(std::current_exception());
+                return;
+            }
+            ready.set_value();
+
+            try {
+                body(state);
+            } catch (...) {
+                state->error = std::current_exception();
+            }
+        });
+
+        try {
+            started.get();
+        } catch (...) {
+            thread.join();
+            throw;
+        }
+    }
+
+    template <typename Rx>
+    bool Stage::listen(Rx& rx, const std::shared_ptr<State>& state) {
+        try {
+            if constexpr (requires { rx.listen(nullptr); }) {
+                try {
+                    rx.listen(std::make_shared<Waker>(state));
+                    state->listening = true;
+                } catch (const std::logic_error&) {
+                }
+            }
+            return true;
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+    }
+
+    template <typename Rx> auto Stage::receive(Rx& rx, State& state) {
+        using T = decltype(rx.recv());
+        try {
+            if constexpr (requires { rx.listen(nullptr); }) {
+                while (state.listening) {
+                    auto seen = state.word.load();
+                    if (state.stopping.load())
+                        return std::optional<T>();
+                    if (auto item = rx.try_recv())
+                        return item;
+                    if constexpr (requires { rx.due(); }) {
+                        if (auto due = rx.due()) {
+                            auto lock = std::unique_lock(state.mutex);
+                            state.changed.wait_until(lock, *due, [&] {
+                                return state.word.load() != seen;
+                            });
+                            continue;
+                        }
+                    }
+                    state.word.wait(seen);
+                }
+            }
+            return std::optional<T>(rx.recv());
+        } catch (const std::runtime_error&) {
+            return std::optional<T>();
+        }
+    }
+
+    template <typename Tx, typename U> bool Stage::send(Tx& tx, U&& item) {
+        try {
+            tx.send(std::forward<U>(item));
+            return true;
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+    }
+
+    template <typename Rx, typename Tx, typename F>
+        requires internal::Consumes<Rx, F>
+    Stage::Stage(Rx rx, Tx tx, F f, Options options) {
+        start(
+            [rx = std::move(rx), tx = std::move(tx),
+             f = std::move(f)](const std::shared_ptr<State>& state) mutable {
+                if (!listen(rx, state))
+                    return;
+                using R = std::invoke_result_t<F&, decltype(rx.recv())>;
+                while (auto item = receive(rx, *state)) {
+                    R result = f(std::move(*item));
+                    if constexpr (internal::is_optional<R>) {
+                        if (result && !send(tx, std::move(*result)))
+                            return;
+                    } else if (!send(tx, std::move(result))) {
+                        return;
+                    }
+                }
+            },
+            std::move(options));
+    }
+
+    template <typename Rx, typename F>
+        requires internal::Consumes<Rx, F>
+    Stage::Stage(Rx rx, F f, Options options) {
+        start(
+            [rx = std::move(rx),
+             f = std::move(f)](const std::shared_ptr<State>& state) mutable {
+                if (!listen(rx, state))
+                    return;
+                while (auto item = receive(rx, *state)) {
+                    try {
+                        f(std::move(*item));
+                    } catch (const internal::Expired&) {
+                        return;
+                    }
+                }
+            },
+            std::move(options));
+    }
+
+    inline Stage& Stage::operator=(Stage&& stage) {
+        if (thread.joinable()) {
+            stop();
+            thread.join();
+        }
+        thread = std::move(stage.thread);
+        state = std::exchange(stage.state, std::make_shared<State>());
+        return *this;
+    }
+
+    inline Stage::~Stage() {
+        if (thread.joinable()) {
+            stop();
+            thread.join();
+        }
+    }
+
+    inline void Stage::stop() {
+        state->stopping.store(true);
+        state->wake();
+    }
+
+    inline void Stage::join() {
+        thread.join();
+        if (auto exception = std::exchange(state->error, nullptr))
+            std::rethrow_exception(exception);
+    }
+} // namespace piper
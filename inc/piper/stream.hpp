@@ -0,0 +1,386 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		stream.hpp
+ * @brief 		Channel bridge over Unix domain sockets and pipes
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <poll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "piper/codec.hpp"
+#include "piper/piper.hpp"
+
+/**
+ * @namespace 	piper::stream
+ * @brief 		Sender and Receiver adapters that carry items over
+ * 				a byte stream, such as a Unix domain socket or a
+ * 				pipe
+ * @details 	Each item is serialized with a Codec into a frame: a
+ * 				32-bit length in host byte order followed by the
+ * 				payload. Both ends must run on the same machine.
+ */
+namespace piper::stream {
+    /**
+     * @class 		Receiver
+     * @brief 		Stream receiver
+     * @details 	Reads the stream in large chunks and parses every
+     * 				complete frame in a chunk before reading again.
+     * @tparam 		T The type of item being received over the stream
+     * @tparam 		Codec The deserializer for items
+     * @implements	piper::Receiver
+     */
+    template <typename T, typename Codec = piper::Codec<T>>
+    class Receiver : public piper::Receiver<T> {
+            int descriptor;
+            std::vector<std::byte> buffer;
+
+            /// The largest payload accepted, in bytes
+            std::size_t limit;
+
+            /// The range of unparsed bytes in buffer
+            std::size_t begin = 0, end = 0;
+
+            /**
+             * @brief 	Reads the next chunk from the stream
+             * @param 	block Whether to wait for the stream to be readable
+             * @return 	Whether any bytes were read
+             * @throws 	std::runtime_error Thrown if the sender has closed
+             * 			the stream
+             */
+            bool fill(bool block);
+
+            /**
+             * @brief 	Parses the next complete frame in the buffer
+             * @return 	The item, or std::nullopt if no complete frame has
+             * 			been read
+             * @throws 	std::runtime_error Thrown if the frame is larger
+             * 			than the limit
+             */
+            std::optional<T> parse();
+
+        public:
+            /**
+             * @brief 	Constructs a Receiver over a stream
+             * @param 	fd The readable end of the stream, owned by the
+             * 			Receiver
+             * @param 	chunk The number of bytes to read at a time
+             * @param 	limit The largest payload accepted, in bytes, so a
+             * 			corrupt length prefix cannot exhaust memory
+             */
+            explicit Receiver(int fd, std::size_t chunk = 1 << 16,
+                              std::size_t limit = 1 << 26)
+                : descriptor(fd), buffer(chunk), limit(limit) {}
+
+            /**
+             * @brief 	Moves a Receiver
+             * @param 	rx The Receiver to move
+             */
+            Receiver(Receiver<T, Codec>&& rx)
+                : descriptor(std::exchange(rx.descriptor, -1)),
+                  buffer(std::move(rx.buffer)), limit(rx.limit),
+                  begin(rx.begin), end(rx.end) {}
+
+            Receiver(const Receiver<T, Codec>&) = delete;
+
+            /**
+             * @brief 	Destructs a Receiver, closing the stream
+             */
+            ~Receiver() {
+                if (descriptor >= 0)
+                    close(descriptor);
+            }
+
+            /**
+             * @brief 	Gets the file descriptor of the stream
+             * @return 	The file descriptor, owned by the Receiver
+             */
+            int fd() const { return descriptor; }
+
+            /**
+             * @brief 	Receives an item from the stream
+             * @return 	The item received from the stream
+             * @throws 	std::runtime_error Thrown if the sender has closed
+             * 			the stream, or a frame is larger than the limit
+             * @note 	Blocks until a whole frame has arrived
+             */
+            T recv() override;
+
+            /**
+             * @brief 	Receives an item from the stream, if one is
+             * 			available
+             * @return 	The item received from the stream, or
+             * 			std::nullopt if no whole frame has arrived
+             * @throws 	std::runtime_error Thrown if the sender has closed
+             * 			the stream, or a frame is larger than the limit
+             */
+            std::optional<T> try_recv() override;
+    };
+
+    template <typename T, typename Codec>
+    bool Receiver<T, Codec>::fill(bool block) {
+        // Make room at the end of the buffer
+        if (begin == end) {
+            begin = end = 0;
+        } else if (end == buffer.size()) {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size())
+            buffer.resize(buffer.size() * 2);
+
+        if (!block) {
+            pollfd entry{descriptor, POLLIN, 0};
+            if (poll(&entry, 1, 0) == 0)
+                return false;
+        }
+
+        ssize_t count;
+        do {
+            count = read(descriptor, buffer.data() + end, buffer.size() - end);
+        } while (count < 0 && errno == EINTR);
+
+        if (count < 0)
+            throw std::system_error(errno, std::generic_category(), "read");
+        if (count == 0)
+            throw std::runtime_error("sender is closed");
+        end += static_cast<std::size_t>(count);
+        return true;
+    }
+
+    template <typename T, typename Codec>
+    std::optional<T> Receiver<T, Codec>::parse() {
+        std::uint32_t length;
+        if (end - begin < sizeof(length))
+            return std::nullopt;
+        std::memcpy(&length, buffer.data() + begin, sizeof(length));
+        if (length > limit)
+            throw std::runtime_error("frame exceeds the size limit");
+
+        // Grow the buffer for frames larger than a chunk
+        auto size = sizeof(length) + length;
+        if (end - begin < size) {
+            if (size > buffer.size())
+                buffer.resize(std::max(size, buffer.size() * 2));
+            return std::nullopt;
+        }
+
+        auto payload = std::span<const std::byte>(
+            buffer.data() + begin + sizeof(length), length);
+        begin += size;
+        return Codec::decode(payload);
+    }
+
+    template <typename T, typename Codec> T Receiver<T, Codec>::recv() {
+        auto item = parse();
+        while (!item) {
+            fill(true);
+            item = parse();
+        }
+        return std::move(*item);
+    }
+
+    template <typename T, typename Codec>
+    std::optional<T> Receiver<T, Codec>::try_recv() {
+        auto item = parse();
+        while (!item && fill(false)) {
+            item = parse();
+        }
+        return item;
+    }
+
+    /**
+     * @class 		Sender
+     * @brief 		Stream sender
+     * @details 	Frames are queued and written together with one
+     * 				writev() call once batch items or bytes are
+     * 				pending, or when flush() is called.
+     * @tparam 		T The type of item being sent over the stream
+     * @tparam 		Codec The serializer for items
+     * @implements	piper::Sender
+     * @note 		Queued frames are not visible to the receiver until
+     * 				they are flushed.
+     * @warning 	Writing to a socket or pipe whose reader has closed
+     * 				raises SIGPIPE unless it is ignored.
+     */
+    template <typename T, typename Codec = piper::Codec<T>>
+    class Sender : public piper::Sender<T> {
+            int descriptor;
+            std::size_t batch, bytes;
+
+            /// The lengths and concatenated payloads of queued frames
+            std::vector<std::uint32_t> lengths;
+            std::vector<std::byte> payloads;
+            std::vector<iovec> vectors;
+
+        public:
+            /**
+             * @brief 	Constructs a Sender over a stream
+             * @param 	fd The writable end of the stream, owned by the
+             * 			Sender
+             * @param 	batch The number of frames to queue before flushing
+             * @param 	bytes The number of payload bytes to queue before
+             * 			flushing
+             */
+            explicit Sender(int fd, std::size_t batch = 64,
+                            std::size_t bytes = 1 << 16)
+                : descriptor(fd), batch(batch), bytes(bytes) {}
+
+            /**
+             * @brief 	Moves a Sender
+             * @param 	tx The Sender to move
+             */
+            Sender(Sender<T, Codec>&& tx)
+                : descriptor(std::exchange(tx.descriptor, -1)),
+                  batch(tx.batch), bytes(tx.bytes),
+                  lengths(std::move(tx.lengths)),
+                  payloads(std::move(tx.payloads)) {}
+
+            Sender(const Sender<T, Codec>&) = delete;
+
+            /**
+             * @brief 	Destructs a Sender, flushing and closing the stream
+             */
+            ~Sender();
+
+            /**
+             * @brief 	Gets the file descriptor of the stream
+             * @return 	The file descriptor, owned by the Sender
+             */
+            int fd() const { return descriptor; }
+
+            /**
+             * @brief 	Copies and sends an item over the stream
+             * @param 	item The item being sent over the stream
+             * @throws 	std::length_error Thrown if the encoded item does
+             * 			not fit in a 32-bit length prefix
+             * @note  	Blocks while a full batch is written
+             */
+            void send(const T& item) override;
+
+            /**
+             * @brief 	Moves and sends an item over the stream
+             * @param 	item The item being sent over the stream
+             * @throws 	std::length_error Thrown if the encoded item does
+             * 			not fit in a 32-bit length prefix
+             * @note  	Blocks while a full batch is written
+             */
+            void send(T&& item) override { send(std::as_const(item)); }
+
+            /**
+             * @brief 	Writes every queued frame to the stream
+             * @throws 	std::system_error Thrown if the stream cannot be
+             * 			written
+             */
+            void flush();
+    };
+
+    template <typename T, typename Codec> Sender<T, Codec>::~Sender() {
+        if (descriptor < 0)
+            return;
+        try {
+            flush();
+        } catch (const std::system_error&) {
+            // The receiver is gone; drop the queued frames
+        }
+        close(descriptor);
+    }
+
+    template <typename T, typename Codec>
+    void Sender<T, Codec>::send(const T& item) {
+        auto size = payloads.size();
+        Codec::encode(item, payloads);
+        auto length = payloads.size() - size;
+        if (length > std::numeric_limits<std::uint32_t>::max()) {
+            payloads.resize(size);
+            throw std::length_error("frame exceeds 4 GiB");
+        }
+        lengths.push_back(static_cast<std::uint32_t>(length));
+
+        if (lengths.size() >= batch || payloads.size() >= bytes)
+            flush();
+    }
+
+    template <typename T, typename Codec> void Sender<T, Codec>::flush() {
+        // Gather the header and payload of each frame
+        vectors.clear();
+        auto payload = payloads.data();
+        for (auto& length : lengths) {
+            vectors.push_back({&length, sizeof(length)});
+            if (length)
+                vectors.push_back({payload, length});
+            payload += length;
+        }
+
+        // Write the frames, resuming after partial writes
+        auto next = vectors.begin();
+        while (next != vectors.end()) {
+            auto count = std::min<std::size_t>(vectors.end() - next, IOV_MAX);
+            auto written = writev(descriptor, &*next, static_cast<int>(count));
+            if (written < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw std::system_error(errno, std::generic_category(),
+                                        "writev");
+            }
+
+            auto remaining = static_cast<std::size_t>(written);
+            while (next != vectors.end() && remaining >= next->iov_len) {
+                remaining -= next->iov_len;
+                next++;
+            }
+            if (remaining) {
+                next->iov_base = static_cast<std::byte*>(next->iov_base) +
+                                 remaining;
+                next->iov_len -= remaining;
+            }
+        }
+
+        lengths.clear();
+        payloads.clear();
+    }
+} // namespace piper::stream
@@ -0,0 +1,374 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		threadpool.hpp
+ * @brief 		Work-stealing thread pool
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "piper/internal/deque.hpp"
+#include "piper/piper.hpp"
+
+namespace piper {
+    /**
+     * @class 	ThreadPool
+     * @brief 	A fixed set of worker threads that run submitted tasks
+     * @details Each worker owns a lock-free work-stealing deque and a
+     * 			lock-free inbox. Tasks submitted by a worker go onto
+     * 			its own deque, and tasks submitted by other threads
+     * 			are spread over the workers' inboxes. An idle worker
+     * 			pops its own deque first, then empties its inbox onto
+     * 			its deque, then steals from the other workers' deques
+     * 			and inboxes. Workers sleep only when no task is
+     * 			queued.
+     * @note 	Destroying the pool runs every queued task before the
+     * 			workers are joined.
+     */
+    class ThreadPool {
+        public:
+            /// A batch of tasks, as received from a channel
+            using Batch = std::vector<std::function<void()>>;
+
+        private:
+            /// A type-erased task
+            struct Job {
+                    /// The next task in an inbox
+                    Job* next = nullptr;
+
+                    virtual ~Job() = default;
+                    virtual void run() = 0;
+            };
+
+            template <typename F> struct Work final : Job {
+                    F f;
+                    explicit Work(F&& f) : f(std::move(f)) {}
+                    void run() override { f(); }
+            };
+
+            /**
+             * @brief 	A lock-free stack of tasks from other threads
+             * @details Any thread may push a task or take every task at
+             * 			once, so there is no ABA hazard.
+             */
+            struct Inbox {
+                    alignas(64) std::atomic<Job*> head{nullptr};
+
+                    void push(Job* job) {
+                        job->next = head.load(std::memory_order_relaxed);
+                        while (!head.compare_exchange_weak(
+                            job->next, job, std::memory_order_release,
+                            std::memory_order_relaxed)) {
+                        }
+                    }
+
+                    /// Takes every task, oldest first
+                    Job* take() {
+                        if (!head.load(std::memory_order_relaxed))
+                            return nullptr;
+                        auto job = head.exchange(nullptr,
+                                                 std::memory_order_acquire);
+                        Job* oldest = nullptr;
+                        while (job) {
+                            auto next = std::exchange(job->next, oldest);
+                            oldest = std::exchange(job, next);
+                        }
+                        return oldest;
+                    }
+            };
+
+            struct Worker {
+                    internal::WorkDeque<Job*> deque;
+                    Inbox inbox;
+                    std::thread thread;
+            };
+
+            /// The pool and worker index of the calling thread, zeroed
+            /// on threads outside any pool
+            struct Identity {
+                    const ThreadPool* pool;
+                    std::size_t index;
+            };
+            static inline thread_local Identity current;
+
+            /// The next inbox for tasks from the calling thread
+            static inline thread_local std::size_t turn =
+                std::hash<std::thread::id>()(std::this_thread::get_id());
+
+            std::vector<std::unique_ptr<Worker>> workers;
+
+            /// Tasks scheduled but not yet taken by a worker
+            std::atomic<std::int64_t> queued{0};
+
+            /// Workers sleeping, or about to sleep, on wake
+            std::atomic<std::size_t> idle{0};
+
+            std::mutex sleep;
+            std::condition_variable wake;
+            bool stopping = false;
+
+            /// Queues a task and wakes an idle worker
+            void schedule(Job* job);
+
+            /**
+             * @brief 	Takes the tasks in an inbox for a worker
+             * @param 	index The worker taking the tasks
+             * @param 	inbox The inbox, the worker's own or another's
+             * @return 	The oldest task, the rest going onto the
+             * 			worker's deque, or std::nullopt if it was empty
+             */
+            std::optional<Job*> collect(std::size_t index, Inbox& inbox);
+
+            /// Takes a task for a worker, or std::nullopt if none is found
+            std::optional<Job*> find(std::size_t index);
+
+            /// Runs tasks on a worker thread until the pool stops
+            void work(std::size_t index);
+
+        public:
+            /**
+             * @brief 	Constructs a ThreadPool and starts its workers
+             * @param 	n The number of worker threads, by default one
+             * 			per hardware thread
+             */
+            explicit ThreadPool(
+                std::size_t n = std::thread::hardware_concurrency());
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool(ThreadPool&&) = delete;
+
+            /**
+             * @brief 	Destructs a ThreadPool, running every queued task
+             * 			and joining the workers
+             */
+            ~ThreadPool();
+
+            /**
+             * @brief 	Gets the number of worker threads
+             */
+            std::size_t size() const { return workers.size(); }
+
+            /**
+             * @brief 	Submits a task
+             * @param 	f The callable to run on a worker
+             * @param 	args The arguments to call f with, copied or moved
+             * 			into the task
+             * @return 	A future holding the result of f, or the
+             * 			exception it threw
+             * @warning Waiting on the future from a worker can deadlock
+             * 			when every worker is waiting.
+             */
+            template <typename F, typename... Args>
+            std::future<std::invoke_result_t<std::decay_t<F>,
+                                             std::decay_t<Args>...>>
+            submit(F&& f, Args&&... args);
+
+            /**
+             * @brief 	Runs every task in a batch
+             * @param 	batch The tasks to run
+             * @details The batch is queued as a single task, which fans
+             * 			its tasks out onto the deque of the worker that
+             * 			takes it, for other workers to steal.
+             * @note 	Exceptions thrown by batch tasks are discarded.
+             */
+            void execute(Batch batch);
+
+            /**
+             * @brief 	Receives a batch and runs its tasks
+             * @param 	rx The receiver of the batch
+             * @return 	The pool, for chained extractions
+             * @note 	Blocks until a batch is received
+             */
+            ThreadPool& operator<<(Receiver<Batch>& rx);
+
+            /**
+             * @brief 	Runs the tasks of every batch available from a
+             * 			receiver
+             * @param 	rx The receiver of the batches
+             * @return 	The number of batches received
+             * @note 	This method does not block
+             */
+            std::size_t drain(Receiver<Batch>& rx);
+    };
+
+    inline ThreadPool::ThreadPool(std::size_t n) {
+        if (n == 0)
+            n = 1;
+        for (std::size_t i = 0; i < n; i++) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t i = 0; i < n; i++) {
+            workers[i]->thread = std::thread(&ThreadPool::work, this, i);
+        }
+    }
+
+    inline ThreadPool::~ThreadPool() {
+        {
+            auto lock = std::unique_lock(sleep);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker->thread.join();
+        }
+    }
+
+    inline void ThreadPool::schedule(Job* job) {
+        if (current.pool == this)
+            workers[current.index]->deque.push(job);
+        else
+            workers[turn++ % workers.size()]->inbox.push(job);
+
+        // Pairs with the idle count in work(): either this thread sees
+        // a sleeping worker, or the worker sees this task
+        queued.fetch_add(1, std::memory_order_seq_cst);
+        if (idle.load(std::memory_order_seq_cst) > 0) {
+            // Wait out a worker between its check and its wait
+            std::lock_guard lock(sleep);
+            wake.notify_one();
+        }
+    }
+
+    inline std::optional<ThreadPool::Job*>
+    ThreadPool::collect(std::size_t index, Inbox& inbox) {
+        auto job = inbox.take();
+        if (!job)
+            return std::nullopt;
+
+        // Queue the rest where other workers can steal them, unlinking
+        // each before a thief can run it
+        auto next = std::exchange(job->next, nullptr);
+        while (next) {
+            auto after = std::exchange(next->next, nullptr);
+            workers[index]->deque.push(next);
+            next = after;
+        }
+        return job;
+    }
+
+    inline std::optional<ThreadPool::Job*>
+    ThreadPool::find(std::size_t index) {
+        if (auto job = workers[index]->deque.pop())
+            return job;
+        if (auto job = collect(index, workers[index]->inbox))
+            return job;
+
+        // Steal, starting from the next worker
+        for (std::size_t i = 1; i < workers.size(); i++) {
+            auto& victim = workers[(index + i) % workers.size()];
+            if (auto job = victim->deque.steal())
+                return job;
+            if (auto job = collect(index, victim->inbox))
+                return job;
+        }
+        return std::nullopt;
+    }
+
+    inline void ThreadPool::work(std::size_t index) {
+        current = {this, index};
+        while (true) {
+            if (auto job = find(index)) {
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                (*job)->run();
+                delete *job;
+                continue;
+            }
+
+            auto lock = std::unique_lock(sleep);
+            idle.fetch_add(1, std::memory_order_seq_cst);
+            wake.wait(lock, [this] {
+                return queued.load(std::memory_order_seq_cst) > 0 || stopping;
+            });
+            idle.fetch_sub(1, std::memory_order_relaxed);
+
+            if (stopping && queued.load(std::memory_order_seq_cst) <= 0)
+                return;
+        }
+    }
+
+    template <typename F, typename... Args>
+    std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    ThreadPool::submit(F&& f, Args&&... args) {
+        using Result =
+            std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        std::packaged_task<Result()> task(
+            [f = std::forward<F>(f),
+             ... args = std::forward<Args>(args)]() mutable -> Result {
+                return std::invoke(std::move(f), std::move(args)...);
+            });
+        auto result = task.get_future();
+        schedule(new Work<std::packaged_task<Result()>>(std::move(task)));
+        return result;
+    }
+
+    inline void ThreadPool::execute(Batch batch) {
+        auto fan_out = [this, batch = std::move(batch)]() mutable {
+            for (auto& task : batch) {
+                auto guarded = [task = std::move(task)] {
+                    try {
+                        task();
+                    } catch (...) {
+                        // Batch tasks have no future to hold exceptions
+                    }
+                };
+                schedule(new Work<decltype(guarded)>(std::move(guarded)));
+            }
+        };
+        schedule(new Work<decltype(fan_out)>(std::move(fan_out)));
+    }
+
+    inline ThreadPool& ThreadPool::operator<<(Receiver<Batch>& rx) {
+        execute(rx.recv());
+        return *this;
+    }
+
+    inline std::size_t ThreadPool::drain(Receiver<Batch>& rx) {
+        std::size_t count = 0;
+        while (auto batch = rx.try_recv()) {
+            execute(std::move(*batch));
+            count++;
+        }
+        return count;
+    }
+} // namespace piper
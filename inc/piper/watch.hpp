@@ -0,0 +1,362 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		watch.hpp
+ * @brief 		Latest-value channel
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "piper/piper.hpp"
+
+namespace piper::watch::internal {
+    /**
+     * @class 	Slot
+     * @brief 	A single value guarded by a sequence lock
+     * @details The sequence word holds a version count above two flag
+     * 			bits: one set while a write is in progress, and one set
+     * 			once the sender is gone. Readers copy the value and
+     * 			retry if the sequence changed meanwhile, so reading
+     * 			never writes shared memory. The value is stored as
+     * 			relaxed atomic words, so racing copies are well
+     * 			defined.
+     * @tparam 	T The type of the value, which must be trivially
+     * 			copyable
+     */
+    template <typename T> class Slot {
+            static_assert(std::is_trivially_copyable_v<T>,
+                          "watch channel values must be trivially copyable");
+
+            static constexpr std::size_t count =
+                (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+            using Words = std::array<std::uint64_t, count>;
+
+            alignas(64) std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::uint32_t> waiters{0};
+            std::array<std::atomic<std::uint64_t>, count> words;
+
+            static Words pack(const T& value) {
+                Words packed{};
+                std::memcpy(packed.data(), &value, sizeof(T));
+                return packed;
+            }
+
+            static T unpack(const Words& packed) {
+                std::array<std::byte, sizeof(T)> bytes;
+                std::memcpy(bytes.data(), packed.data(), sizeof(T));
+                return std::bit_cast<T>(bytes);
+            }
+
+        public:
+            /// Set while a write is in progress
+            static constexpr std::uint64_t writing = 1;
+
+            /// Set once the sender is gone
+            static constexpr std::uint64_t closed = 2;
+
+            /// The sequence increment of one write
+            static constexpr std::uint64_t step = 4;
+
+            /**
+             * @brief 	Constructs a Slot holding an initial value
+             * @param 	value The initial value, at version 0
+             */
+            explicit Slot(const T& value);
+
+            /**
+             * @brief 	Overwrites the value and wakes blocked readers
+             * @param 	value The new value
+             * @note 	Concurrent writers are serialized
+             */
+            void store(const T& value);
+
+            /**
+             * @brief 	Takes a consistent copy of the value
+             * @return 	The value and the sequence word it was read at
+             */
+            std::pair<T, std::uint64_t> load() const;
+
+            /**
+             * @brief 	Blocks until the sequence word differs from seen
+             * @param 	seen A sequence word previously read
+             */
+            void wait(std::uint64_t seen);
+
+            /**
+             * @brief 	Marks the sender as gone and wakes blocked readers
+             */
+            void close();
+
+            /// Gets the current sequence word
+            std::uint64_t peek() const {
+                return sequence.load(std::memory_order_acquire);
+            }
+    };
+
+    template <typename T> Slot<T>::Slot(const T& value) {
+        auto packed = pack(value);
+        for (std::size_t i = 0; i < count; i++) {
+            words[i].store(packed[i], std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T> void Slot<T>::store(const T& value) {
+        auto packed = pack(value);
+
+        // Acquire the write lock
+        auto seq = sequence.load(std::memory_order_relaxed);
+        while ((seq & writing) ||
+               !sequence.compare_exchange_weak(seq, seq | writing,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+            seq = sequence.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = 0; i < count; i++) {
+            words[i].store(packed[i], std::memory_order_relaxed);
+        }
+
+        // Publish the new version and release the lock
+        // Pairs with the waiter count in wait(): either this thread
+        // sees a waiter, or the waiter sees the new version
+        sequence.store(seq + step, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) > 0)
+            sequence.notify_all();
+    }
+
+    template <typename T> std::pair<T, std::uint64_t> Slot<T>::load() const {
+        Words packed;
+        std::uint64_t before, after;
+        do {
+            before = sequence.load(std::memory_order_acquire);
+            while (before & writing) {
+                before = sequence.load(std::memory_order_acquire);
+            }
+            for (std::size_t i = 0; i < count; i++) {
+                packed[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence.load(std::memory_order_relaxed);
+        } while (before != after);
+        return {unpack(packed), before};
+    }
+
+    template <typename T> void Slot<T>::wait(std::uint64_t seen) {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        sequence.wait(seen, std::memory_order_seq_cst);
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    template <typename T> void Slot<T>::close() {
+        sequence.fetch_or(closed, std::memory_order_release);
+        sequence.notify_all();
+    }
+} // namespace piper::watch::internal
+
+/**
+ * @namespace 	piper::watch
+ * @brief 		Concrete Sender and Receiver implementations for
+ * 				channels that hold only the latest value
+ */
+namespace piper::watch {
+    template <typename T> class Sender;
+    template <typename T> class Receiver;
+
+    /**
+     * @brief 	Creates a connected Sender and Receiver
+     * @tparam 	T The type of the value, which must be trivially
+     * 			copyable
+     * @param 	value The initial value
+     * @return 	The Sender and Receiver
+     */
+    template <typename T>
+    std::pair<Sender<T>, Receiver<T>> channel(const T& value = T());
+
+    /**
+     * @class 		Receiver
+     * @brief 		Watch channel receiver
+     * @details 	Each Receiver remembers the version it last
+     * 				received. Copies of a Receiver share the channel
+     * 				but track versions independently.
+     * @tparam 		T The type of the value being received
+     * @implements	piper::Receiver
+     */
+    template <typename T> class Receiver : public piper::Receiver<T> {
+            using Slot = internal::Slot<T>;
+
+            std::shared_ptr<Slot> slot;
+            std::uint64_t seen;
+
+            Receiver(std::shared_ptr<Slot> slot, std::uint64_t seen)
+                : slot(std::move(slot)), seen(seen) {}
+
+            friend class Sender<T>;
+            friend std::pair<Sender<T>, Receiver<T>> channel<T>(const T&);
+
+            /// Strips the flag bits from a sequence word
+            static std::uint64_t version(std::uint64_t seq) {
+                return seq & ~(Slot::writing | Slot::closed);
+            }
+
+        public:
+            Receiver(const Receiver<T>&) = default;
+            Receiver(Receiver<T>&&) = default;
+
+            /**
+             * @brief 	Gets the latest value without waiting
+             * @return 	The latest value
+             * @note 	This method does not mark the value as received
+             */
+            T get() const { return slot->load().first; }
+
+            /**
+             * @brief 	Checks whether a value newer than the last one
+             * 			received has been sent
+             */
+            bool changed() const {
+                return version(slot->peek()) != version(seen);
+            }
+
+            /**
+             * @brief 	Receives the next value
+             * @return 	The latest value, once it differs from the last
+             * 			one received
+             * @throws 	std::runtime_error Thrown if the Sender is
+             * 			expired and no newer value was sent
+             * @note 	Blocks until a newer value is sent; intermediate
+             * 			values may be skipped
+             */
+            T recv() override;
+
+            /**
+             * @brief 	Receives the next value, if one has been sent
+             * @return 	The latest value, or std::nullopt if it has
+             * 			already been received
+             * @throws 	std::runtime_error Thrown if the Sender is
+             * 			expired and no newer value was sent
+             */
+            std::optional<T> try_recv() override;
+    };
+
+    template <typename T> T Receiver<T>::recv() {
+        while (true) {
+            if (auto value = try_recv())
+                return *value;
+            slot->wait(seen);
+        }
+    }
+
+    template <typename T> std::optional<T> Receiver<T>::try_recv() {
+        auto seq = slot->peek();
+        if (version(seq) == version(seen)) {
+            if (seq & Slot::closed)
+                throw std::runtime_error("sender is expired");
+            seen = seq;
+            return std::nullopt;
+        }
+
+        auto [value, at] = slot->load();
+        seen = at;
+        return value;
+    }
+
+    /**
+     * @class 		Sender
+     * @brief 		Watch channel sender
+     * @details 	Each send overwrites the value and wakes blocked
+     * 				Receivers. Dropping the Sender wakes them too,
+     * 				and they throw once they have received the last
+     * 				value.
+     * @tparam 		T The type of the value being sent
+     * @implements	piper::Sender
+     */
+    template <typename T> class Sender : public piper::Sender<T> {
+            std::shared_ptr<internal::Slot<T>> slot;
+
+            explicit Sender(std::shared_ptr<internal::Slot<T>> slot)
+                : slot(std::move(slot)) {}
+
+            friend std::pair<Sender<T>, Receiver<T>> channel<T>(const T&);
+
+        public:
+            Sender(Sender<T>&&) = default;
+            Sender(const Sender<T>&) = delete;
+
+            /**
+             * @brief 	Destructs a Sender, waking blocked Receivers
+             */
+            ~Sender() {
+                if (slot)
+                    slot->close();
+            }
+
+            /**
+             * @brief 	Creates a Receiver that has seen the latest value
+             * @return 	The new Receiver
+             */
+            Receiver<T> subscribe() const {
+                return Receiver<T>(slot, slot->peek());
+            }
+
+            /**
+             * @brief 	Overwrites the value
+             * @param 	item The new value
+             * @note 	This method does not block on readers
+             */
+            void send(const T& item) override { slot->store(item); }
+
+            /**
+             * @brief 	Overwrites the value
+             * @param 	item The new value
+             * @note 	This method does not block on readers
+             */
+            void send(T&& item) override { slot->store(item); }
+    };
+
+    template <typename T>
+    std::pair<Sender<T>, Receiver<T>> channel(const T& value) {
+        auto slot = std::make_shared<internal::Slot<T>>(value);
+        auto seen = slot->peek();
+        return {Sender<T>(slot), Receiver<T>(slot, seen)};
+    }
+} // namespace piper::watch
@@ -0,0 +1,709 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file 		window.hpp
+ * @brief 		Tumbling, sliding and session window aggregation
+ * @author 		Brian Reece
+ * @version 	0.1
+ * @copyright 	MIT License
+ * @date 		2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "piper/internal/buffer.hpp"
+#include "piper/piper.hpp"
+
+namespace piper {
+    /**
+     * @struct 	Window
+     * @brief 	The aggregate of the items in one window
+     * @tparam 	V The type of aggregate
+     */
+    template <typename V> struct Window {
+            /// The bounds of the window, [start, end), on the timeline of
+            /// the windower's time source
+            std::chrono::nanoseconds start;
+            std::chrono::nanoseconds end;
+
+            /// The aggregate, and the number of items in it
+            V value;
+            std::size_t count;
+    };
+
+    /**
+     * @struct 	Reducer
+     * @brief 	A monoid to aggregate items with
+     * @details Each item is lifted into a value, and values are
+     * 			combined with an associative function, of which identity
+     * 			is the neutral element.
+     * @note 	Items of a window may be combined out of time order if
+     * 			they arrive out of order, or were gathered in different
+     * 			panes, so combine should then also be commutative.
+     */
+    template <typename V, typename Combine, typename Lift> struct Reducer {
+            V identity;
+            Combine combine;
+            Lift lift;
+    };
+
+    /**
+     * @brief 	Creates a Reducer
+     * @param 	identity The neutral value
+     * @param 	combine The associative function combining two values
+     * @param 	lift The function turning an item into a value
+     */
+    template <typename V, typename Combine, typename Lift = std::identity>
+    Reducer<V, Combine, Lift> reducer(V identity, Combine combine,
+                                      Lift lift = {}) {
+        return {std::move(identity), std::move(combine), std::move(lift)};
+    }
+
+    /**
+     * @struct 	Windowing
+     * @brief 	How items are grouped into windows
+     */
+    struct Windowing {
+            enum class Kind { tumbling, sliding, session };
+
+            Kind kind;
+
+            /// The length of each window, or the gap closing a session
+            std::chrono::nanoseconds size;
+
+            /// The distance between the starts of successive windows
+            std::chrono::nanoseconds slide;
+    };
+
+    /**
+     * @brief 	Groups items into back-to-back windows of equal size
+     * @param 	size The length of each window
+     */
+    inline Windowing tumbling(std::chrono::nanoseconds size) {
+        return {Windowing::Kind::tumbling, size, size};
+    }
+
+    /**
+     * @brief 	Groups items into overlapping windows of equal size
+     * @param 	size The length of each window
+     * @param 	slide The distance between the starts of windows
+     */
+    inline Windowing sliding(std::chrono::nanoseconds size,
+                             std::chrono::nanoseconds slide) {
+        return {Windowing::Kind::sliding, size, slide};
+    }
+
+    /**
+     * @brief 	Groups items into sessions of activity
+     * @param 	gap The idle time that closes a session
+     */
+    inline Windowing session(std::chrono::nanoseconds gap) {
+        return {Windowing::Kind::session, gap, gap};
+    }
+
+    /**
+     * @struct 	ProcessingTime
+     * @brief 	Timestamps items with the steady clock as they are
+     * 			received, so windows close as the clock passes them
+     */
+    struct ProcessingTime {
+            static constexpr bool event = false;
+            static constexpr std::chrono::nanoseconds lateness{0};
+
+            static std::chrono::nanoseconds now() {
+                return std::chrono::steady_clock::now().time_since_epoch();
+            }
+
+            template <typename T>
+            std::chrono::nanoseconds operator()(const T&) const {
+                return now();
+            }
+    };
+
+    /**
+     * @struct 	EventTime
+     * @brief 	Timestamps items with a time carried by each item, so
+     * 			windows close as later items arrive
+     */
+    template <typename F> struct EventTime {
+            static constexpr bool event = true;
+
+            F f;
+
+            /// How far behind the latest item an item may arrive
+            std::chrono::nanoseconds lateness;
+
+            template <typename T>
+            std::chrono::nanoseconds operator()(const T& item) {
+                auto time = f(item);
+                if constexpr (requires { time.time_since_epoch(); })
+                    return std::chrono::duration_cast<
+                        std::chrono::nanoseconds>(time.time_since_epoch());
+                else
+                    return std::chrono::duration_cast<
+                        std::chrono::nanoseconds>(time);
+            }
+    };
+
+    /**
+     * @brief 	Creates an event time source
+     * @param 	f Gets an item's time, as a duration or time point
+     * @param 	lateness How far behind the latest item an item may
+     * 			arrive before it is dropped
+     */
+    template <typename F>
+    EventTime<F> event_time(F f, std::chrono::nanoseconds lateness = {}) {
+        return {std::move(f), lateness};
+    }
+} // namespace piper
+
+namespace piper::internal {
+    /// Divides, rounding towards negative infinity
+    inline std::int64_t floor_div(std::int64_t a, std::int64_t b) {
+        return a / b - (a % b != 0 && (a < 0) != (b < 0));
+    }
+
+    /**
+     * @class 	TwoStack
+     * @brief 	A FIFO queue that aggregates its contents in amortized
+     * 			constant time
+     * @details Values are pushed onto a back stack, which keeps its
+     * 			running aggregate. Values are popped from a front stack,
+     * 			each entry of which holds the aggregate of itself and
+     * 			every newer entry below it. When the front runs empty,
+     * 			the back stack is flipped onto it, so each value is
+     * 			moved and combined once.
+     * @tparam 	V The type of value
+     */
+    template <typename V> class TwoStack {
+            struct Entry {
+                    std::int64_t key;
+                    V value;
+                    V aggregate;
+            };
+
+            std::vector<Entry> front, back;
+            V identity;
+            V rear;
+
+            template <typename Combine> void flip(const Combine& combine);
+
+        public:
+            explicit TwoStack(V identity)
+                : identity(identity), rear(std::move(identity)) {}
+
+            bool empty() const { return front.empty() && back.empty(); }
+
+            /// Appends a value, ordered by key
+            template <typename Combine>
+            void push(std::int64_t key, V value, const Combine& combine);
+
+            /// Gets the key of the oldest value
+            template <typename Combine>
+            std::int64_t oldest(const Combine& combine);
+
+            /// Removes the oldest value
+            template <typename Combine> void pop(const Combine& combine);
+
+            /// Combines every value, oldest first
+            template <typename Combine> V query(const Combine& combine) const;
+    };
+
+    template <typename V>
+    template <typename Combine>
+    void TwoStack<V>::flip(const Combine& combine) {
+        while (!back.empty()) {
+            auto entry = std::move(back.back());
+            back.pop_back();
+            entry.aggregate =
+                front.empty() ? entry.value
+                              : combine(entry.value, front.back().aggregate);
+            front.push_back(std::move(entry));
+        }
+        rear = identity;
+    }
+
+    template <typename V>
+    template <typename Combine>
+    void TwoStack<V>::push(std::int64_t key, V value, const Combine& combine) {
+        rear = combine(rear, value);
+        back.push_back({key, std::move(value), identity});
+    }
+
+    template <typename V>
+    template <typename Combine>
+    std::int64_t TwoStack<V>::oldest(const Combine& combine) {
+        if (front.empty())
+            flip(combine);
+        return front.back().key;
+    }
+
+    template <typename V>
+    template <typename Combine>
+    void TwoStack<V>::pop(const Combine& combine) {
+        if (front.empty())
+            flip(combine);
+        front.pop_back();
+    }
+
+    template <typename V>
+    template <typename Combine>
+    V TwoStack<V>::query(const Combine& combine) const {
+        return front.empty() ? rear : combine(front.back().aggregate, rear);
+    }
+} // namespace piper::internal
+
+namespace piper {
+    /**
+     * @class 	Windower
+     * @brief 	A Receiver of window aggregates, computed from a Receiver
+     * 			of items
+     * @details Every item is folded into its window in constant time.
+     * 			Tumbling and sliding windows are cut into panes as long
+     * 			as the greatest common divisor of their size and slide.
+     * 			Each item is combined into its pane, and each window is
+     * 			the aggregate of its panes, kept in a two-stack queue
+     * 			so sliding a window costs amortized constant time no
+     * 			matter how many panes it spans. Sessions aggregate as
+     * 			they grow, and merge when an item bridges them.
+     *
+     * 			A window is handed out once the watermark passes its
+     * 			end. With processing time the watermark is the clock,
+     * 			and windows close even while no items arrive. With
+     * 			event time it trails the latest item by the allowed
+     * 			lateness, and items behind it are dropped. Windows
+     * 			without items are not handed out. Once the source
+     * 			expires, every open window is handed out before
+     * 			receiving throws.
+     * @tparam 	Rx The type of the source, which must accept a
+     * 			readiness listener, e.g. an MPSC or SPMC Receiver
+     * @tparam 	R The type of Reducer
+     * @tparam 	Time The type of time source
+     * @note 	The windower replaces any listener on its source, and
+     * 			forwards its notifications to its own listener.
+     */
+    template <typename Rx, typename R, typename Time = ProcessingTime>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    class Windower final
+        : public Receiver<Window<std::remove_cvref_t<decltype(R::identity)>>> {
+        public:
+            /// The type of item aggregated
+            using Item =
+                std::remove_cvref_t<decltype(std::declval<Rx&>().recv())>;
+
+            /// The type of aggregate
+            using Value = std::remove_cvref_t<decltype(R::identity)>;
+
+        private:
+            /// An aggregate, and the number of items in it
+            struct Partial {
+                    Value value;
+                    std::size_t count;
+            };
+
+            /// An open session, whose items lie in [start, last]
+            struct Session {
+                    std::int64_t start;
+                    std::int64_t last;
+                    Partial partial;
+            };
+
+            /// Counts readiness notifications from the source, and
+            /// forwards them to a listener
+            struct Signal {
+                    std::mutex mutex;
+                    std::condition_variable changed;
+                    std::uint64_t count = 0;
+                    std::shared_ptr<internal::Listener> listener;
+
+                    void notify() {
+                        std::shared_ptr<internal::Listener> outer;
+                        {
+                            auto lock = std::unique_lock(mutex);
+                            count++;
+                            outer = listener;
+                        }
+                        changed.notify_all();
+                        if (outer)
+                            outer->filled();
+                    }
+            };
+
+            /// Notifies on a filled or destroyed source buffer
+            struct Wake final : internal::Listener {
+                    std::shared_ptr<Signal> signal;
+                    explicit Wake(std::shared_ptr<Signal> signal)
+                        : signal(std::move(signal)) {}
+                    ~Wake() { signal->notify(); }
+                    void filled() override { signal->notify(); }
+                    void drained() override {}
+            };
+
+            static constexpr std::int64_t never =
+                std::numeric_limits<std::int64_t>::min();
+            static constexpr std::int64_t forever =
+                std::numeric_limits<std::int64_t>::max();
+
+            Rx rx;
+            Windowing shape;
+            R reducer;
+            Time time;
+
+            std::shared_ptr<Signal> signal = std::make_shared<Signal>();
+            std::deque<Window<Value>> ready;
+            bool expired = false;
+
+            /// The latest item time, and the time before which every
+            /// window is closed
+            std::int64_t latest = never;
+            std::int64_t watermark = never;
+
+            /// The open panes by index, the closed panes of the next
+            /// window, and its end, if any pane is pending
+            std::int64_t pane = 0;
+            std::map<std::int64_t, Partial> panes;
+            internal::TwoStack<Partial> window;
+            std::optional<std::int64_t> next;
+
+            /// The open sessions, ordered by start
+            std::vector<Session> sessions;
+
+            Partial combine(const Partial& a, const Partial& b) const {
+                return {reducer.combine(a.value, b.value), a.count + b.count};
+            }
+
+            /// Folds an item into its pane or session
+            void add(std::int64_t at, Item&& item);
+
+            /// Advances the watermark, closing the windows it passes
+            void advance(std::int64_t to);
+
+            /// Closes the sliding or tumbling window ending at end
+            void close(std::int64_t end);
+
+            /// Gets when the next window closes by the clock, if any
+            std::optional<std::int64_t> deadline() const;
+
+            /// Takes available items, and closes windows
+            void pump();
+
+        public:
+            /**
+             * @brief 	Constructs a Windower
+             * @param 	rx The source, owned by the windower
+             * @param 	shape How items are grouped into windows
+             * @param 	reducer How the items of a window are aggregated
+             * @param 	time How items are timestamped
+             * @throws 	std::logic_error Thrown if the size, slide or gap
+             * 			is not positive
+             */
+            Windower(Rx rx, Windowing shape, R reducer, Time time = {});
+
+            Windower(Windower&&) = default;
+            Windower(const Windower&) = delete;
+
+            /**
+             * @brief 	Receives the next closed window
+             * @throws 	std::runtime_error Thrown once the source has
+             * 			expired and every window has been handed out
+             * @note 	Blocks until a window closes
+             */
+            Window<Value> recv() override;
+
+            /**
+             * @brief 	Receives the next closed window, if any
+             * @throws 	std::runtime_error Thrown once the source has
+             * 			expired and every window has been handed out
+             */
+            std::optional<Window<Value>> try_recv() override;
+
+            /**
+             * @brief 	Attaches a readiness listener to the windower
+             * @param 	listener Notified whenever the source may have
+             * 			become ready, or has expired
+             * @note 	With processing time, a window also closes at
+             * 			due().
+             */
+            void listen(std::shared_ptr<internal::Listener> listener);
+
+            /**
+             * @brief 	Gets when the next window closes by the clock
+             * @return 	The time, or std::nullopt if no window is open
+             * 			or windows close by event time
+             */
+            std::optional<std::chrono::steady_clock::time_point> due() const;
+    };
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    Windower<Rx, R, Time>::Windower(Rx rx, Windowing shape, R reducer,
+                                    Time time)
+        : rx(std::move(rx)), shape(shape), reducer(std::move(reducer)),
+          time(std::move(time)), window(Partial{this->reducer.identity, 0}) {
+        if (shape.size.count() <= 0 || shape.slide.count() <= 0)
+            throw std::logic_error("window is not positive");
+        pane = std::gcd(shape.size.count(), shape.slide.count());
+
+        try {
+            this->rx.listen(std::make_shared<Wake>(signal));
+        } catch (const std::runtime_error&) {
+            // An expired source throws again when received from
+        }
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    void Windower<Rx, R, Time>::add(std::int64_t at, Item&& item) {
+        auto size = shape.size.count();
+        Partial partial{reducer.lift(std::move(item)), 1};
+
+        if (shape.kind == Windowing::Kind::session) {
+            // Items closing no later than the watermark are late
+            if (at + size <= watermark)
+                return;
+
+            // An item within a gap of a session joins it, and may
+            // bridge it with the next one
+            auto after = std::upper_bound(
+                sessions.begin(), sessions.end(), at,
+                [](std::int64_t at, const Session& session) {
+                    return at < session.start;
+                });
+            bool joins_before = after != sessions.begin() &&
+                                std::prev(after)->last + size > at;
+            bool joins_after = after != sessions.end() &&
+                               at + size > after->start;
+
+            if (joins_before) {
+                auto& joined = *std::prev(after);
+                joined.last = std::max(joined.last, at);
+                joined.partial = combine(joined.partial, partial);
+                if (joins_after) {
+                    joined.last = after->last;
+                    joined.partial = combine(joined.partial, after->partial);
+                    sessions.erase(after);
+                }
+            } else if (joins_after) {
+                after->start = at;
+                after->partial = combine(partial, after->partial);
+            } else {
+                sessions.insert(after, {at, at, std::move(partial)});
+            }
+            return;
+        }
+
+        // Items in panes the watermark has passed are late
+        auto index = internal::floor_div(at, pane);
+        if ((index + 1) * pane <= watermark)
+            return;
+
+        // A late item may belong to windows before the next one
+        auto slide = shape.slide.count();
+        auto first = (internal::floor_div(at, slide) + 1) * slide;
+        next = next ? std::min(*next, first) : first;
+
+        // Items mostly arrive in order, so try the newest pane first
+        if (!panes.empty() && panes.rbegin()->first == index) {
+            auto& open = panes.rbegin()->second;
+            open = combine(open, partial);
+        } else if (auto [it, added] = panes.try_emplace(index, partial);
+                   !added) {
+            it->second = combine(it->second, partial);
+        }
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    void Windower<Rx, R, Time>::close(std::int64_t end) {
+        auto merge = [this](const Partial& a, const Partial& b) {
+            return combine(a, b);
+        };
+        auto size = shape.size.count();
+        auto slide = shape.slide.count();
+
+        // Seal the panes of this window, and drop those before it
+        while (!panes.empty() && panes.begin()->first < end / pane) {
+            auto sealed = panes.begin();
+            window.push(sealed->first, std::move(sealed->second), merge);
+            panes.erase(sealed);
+        }
+        while (!window.empty() && window.oldest(merge) < (end - size) / pane)
+            window.pop(merge);
+
+        if (!window.empty()) {
+            auto partial = window.query(merge);
+            ready.push_back({std::chrono::nanoseconds(end - size),
+                             std::chrono::nanoseconds(end),
+                             std::move(partial.value), partial.count});
+        }
+
+        // Skip windows that would be empty
+        next = end + slide;
+        if (window.empty()) {
+            if (panes.empty())
+                next.reset();
+            else
+                next = std::max(*next, (internal::floor_div(
+                                            panes.begin()->first * pane,
+                                            slide) + 1) * slide);
+        }
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    void Windower<Rx, R, Time>::advance(std::int64_t to) {
+        watermark = std::max(watermark, to);
+        if (shape.kind != Windowing::Kind::session) {
+            while (next && *next <= watermark)
+                close(*next);
+            return;
+        }
+
+        auto gap = shape.size.count();
+        while (!sessions.empty() &&
+               sessions.front().last + gap <= watermark) {
+            auto& closed = sessions.front();
+            ready.push_back({std::chrono::nanoseconds(closed.start),
+                             std::chrono::nanoseconds(closed.last + gap),
+                             std::move(closed.partial.value),
+                             closed.partial.count});
+            sessions.erase(sessions.begin());
+        }
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    std::optional<std::int64_t> Windower<Rx, R, Time>::deadline() const {
+        if (shape.kind != Windowing::Kind::session)
+            return next;
+        if (sessions.empty())
+            return std::nullopt;
+        return sessions.front().last + shape.size.count();
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    void Windower<Rx, R, Time>::pump() {
+        try {
+            while (!expired && ready.empty()) {
+                auto item = rx.try_recv();
+                if (!item)
+                    break;
+                auto at = time(std::as_const(*item)).count();
+                add(at, std::move(*item));
+                latest = std::max(latest, at);
+                advance(latest - time.lateness.count());
+            }
+        } catch (const std::runtime_error&) {
+            expired = true;
+        }
+
+        if constexpr (!Time::event)
+            advance(Time::now().count());
+        if (expired)
+            advance(forever);
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    std::optional<Window<typename Windower<Rx, R, Time>::Value>>
+    Windower<Rx, R, Time>::try_recv() {
+        pump();
+        if (!ready.empty()) {
+            auto closed = std::move(ready.front());
+            ready.pop_front();
+            return closed;
+        }
+        if (expired)
+            throw std::runtime_error("sender is expired");
+        return std::nullopt;
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    Window<typename Windower<Rx, R, Time>::Value>
+    Windower<Rx, R, Time>::recv() {
+        for (;;) {
+            std::uint64_t seen;
+            {
+                auto lock = std::unique_lock(signal->mutex);
+                seen = signal->count;
+            }
+            if (auto closed = try_recv())
+                return std::move(*closed);
+
+            auto lock = std::unique_lock(signal->mutex);
+            auto notified = [&] { return signal->count != seen; };
+            if (auto until = due())
+                signal->changed.wait_until(lock, *until, notified);
+            else
+                signal->changed.wait(lock, notified);
+        }
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    void Windower<Rx, R, Time>::listen(
+        std::shared_ptr<internal::Listener> listener) {
+        {
+            auto lock = std::unique_lock(signal->mutex);
+            signal->listener = listener;
+        }
+
+        // The source may already hold items, which will not notify again
+        if (listener)
+            listener->filled();
+    }
+
+    template <typename Rx, typename R, typename Time>
+        requires requires(Rx& rx) { rx.listen(nullptr); }
+    std::optional<std::chrono::steady_clock::time_point>
+    Windower<Rx, R, Time>::due() const {
+        using Clock = std::chrono::steady_clock;
+        auto until = deadline();
+        if (Time::event || !until)
+            return std::nullopt;
+        return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::nanoseconds(*until)));
+    }
+} // namespace piper
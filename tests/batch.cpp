@@ -0,0 +1,187 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		batch.cpp
+ * @brief		Micro-batching testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE batch
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "piper/batch.hpp"
+#include "piper/mpsc.hpp"
+#include "piper/spmc.hpp"
+#include "piper/stage.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::batch
+ * @brief		Testing suite for the micro-batching receiver
+ */
+namespace piper::tests::batch {
+    using namespace std::chrono_literals;
+    using Clock = std::chrono::steady_clock;
+
+    BOOST_AUTO_TEST_SUITE(batcher)
+
+    /**
+     * @test 	batcher/flush
+     * @brief 	Asserts that batches are handed out when full, and that
+     * 			a partial batch is handed out once overdue.
+     */
+    BOOST_AUTO_TEST_CASE(flush) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        piper::Batcher rx(std::move(source), 4, 50ms);
+
+        for (int i = 0; i < 10; i++) {
+            tx << i;
+        }
+        BOOST_TEST(rx.recv() == std::vector<int>({0, 1, 2, 3}));
+        BOOST_TEST(rx.recv() == std::vector<int>({4, 5, 6, 7}));
+        BOOST_TEST(!rx.try_recv());
+
+        auto start = Clock::now();
+        BOOST_TEST(rx.recv() == std::vector<int>({8, 9}));
+        BOOST_TEST((Clock::now() - start >= 40ms));
+    }
+
+    /**
+     * @test 	batcher/expiry
+     * @brief 	Asserts that gathered items are handed out when the
+     * 			source expires, before receiving throws.
+     */
+    BOOST_AUTO_TEST_CASE(expiry) {
+        auto tx = std::make_unique<spmc::Sender<int>>();
+        piper::Batcher rx(spmc::Receiver<int>(*tx), 10, 1h);
+        *tx << 1 << 2 << 3;
+
+        std::thread closer([&] {
+            std::this_thread::sleep_for(20ms);
+            tx.reset();
+        });
+        BOOST_TEST(rx.recv() == std::vector<int>({1, 2, 3}));
+        BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+        closer.join();
+    }
+
+    /**
+     * @test 	batcher/adaptive
+     * @brief 	Asserts that an adaptive batcher shrinks its batches for
+     * 			a slow stream, and grows them again for a fast one.
+     */
+    BOOST_AUTO_TEST_CASE(adaptive) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        piper::Batcher rx(std::move(source), 100, 20ms, true);
+        BOOST_TEST(rx.size() == 100u);
+
+        // About one item per delay, so waiting for more only adds latency
+        for (int i = 0; i < 8; i++) {
+            tx << i;
+            rx.recv();
+            std::this_thread::sleep_for(20ms);
+        }
+        BOOST_TEST(rx.size() < 10u);
+
+        for (int i = 0; i < 10000; i++) {
+            tx << i;
+        }
+        while (rx.size() < 100u) {
+            rx.recv();
+        }
+        BOOST_TEST(rx.recv().size() == 100u);
+    }
+
+    /**
+     * @test 	batcher/backlog
+     * @brief 	Asserts that an adaptive batcher grows its batches for a
+     * 			backlog behind a sink slower than the delay, even after
+     * 			a quiet period shrank them.
+     */
+    BOOST_AUTO_TEST_CASE(backlog) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        piper::Batcher rx(std::move(source), 1000, 5ms, true);
+
+        for (int i = 0; i < 4; i++) {
+            tx << i;
+            rx.recv();
+            std::this_thread::sleep_for(10ms);
+        }
+        BOOST_TEST(rx.size() == 1u);
+
+        for (int i = 0; i < 100000; i++) {
+            tx << i;
+        }
+        std::size_t largest = 0;
+        for (int i = 0; i < 16; i++) {
+            largest = std::max(largest, rx.recv().size());
+            std::this_thread::sleep_for(10ms);
+        }
+        BOOST_TEST(largest == 1000u);
+    }
+
+    /**
+     * @test 	batcher/stage
+     * @brief 	Asserts that a stage waits on a batcher through its
+     * 			listener, waking for an overdue batch, and stops on
+     * 			request while its source stays open.
+     */
+    BOOST_AUTO_TEST_CASE(stage) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        std::atomic<int> sum = 0;
+
+        piper::Stage stage(piper::Batcher(std::move(source), 4, 20ms),
+                           [&](std::vector<int> batch) {
+                               for (int x : batch) {
+                                   sum += x;
+                               }
+                           });
+        tx << 1 << 2 << 3;
+        while (sum != 6) {
+            std::this_thread::sleep_for(1ms);
+        }
+
+        stage.stop();
+        stage.join();
+        BOOST_TEST(sum == 6);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // batcher
+} // namespace piper::tests::batch
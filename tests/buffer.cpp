@@ -0,0 +1,685 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		buffer.cpp
+ * @brief		Buffer flavor testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+#define BOOST_TEST_MODULE buffer
+#include <boost/test/unit_test.hpp>
+
+#include <csignal>
+#include <filesystem>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "piper/factory.hpp"
+#include "piper/internal/log.hpp"
+#include "piper/internal/spill.hpp"
+#include "piper/mpsc.hpp"
+#include "piper/spmc.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::buffer
+ * @brief		Testing suite for buffer flavors
+ */
+namespace piper::tests::buffer {
+    BOOST_AUTO_TEST_SUITE(buffer_static)
+
+    /**
+     * @test 	buffer_static/wraparound
+     * @brief 	Asserts that items keep FIFO order as the ring
+     * 			wraps around several times.
+     */
+    BOOST_AUTO_TEST_CASE(wraparound) {
+        auto [tx, rx] = piper::make_channel<int, piper::mpsc::Topology,
+                                            flavor::Static<4>>();
+        std::thread worker(
+            [](auto&& tx) {
+                for (int i = 0; i < 100; i++) {
+                    tx << i;
+                }
+            },
+            std::move(tx));
+        for (int i = 0; i < 100; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+        worker.join();
+    }
+
+    /**
+     * @test 	buffer_static/inline_storage
+     * @brief 	Asserts that the ring is stored inside the buffer.
+     */
+    BOOST_AUTO_TEST_CASE(inline_storage) {
+        using Buffer = piper::internal::StaticBuffer<int, 16>;
+        BOOST_TEST(sizeof(Buffer) >= 16 * sizeof(int));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // buffer_static
+
+    BOOST_AUTO_TEST_SUITE(buffer_priority)
+
+    /**
+     * @test 	buffer_priority/order
+     * @brief 	Asserts that items are received greatest first.
+     */
+    BOOST_AUTO_TEST_CASE(order) {
+        auto [tx, rx] = piper::make_channel<int, piper::mpsc::Topology,
+                                            flavor::Priority<>>();
+        for (int i : {3, 9, 1, 7, 5, 2, 8, 6, 4, 0}) {
+            tx << i;
+        }
+        for (int i = 9; i >= 0; i--) {
+            BOOST_TEST(rx.recv() == i);
+        }
+    }
+
+    /**
+     * @test 	buffer_priority/fifo_ties
+     * @brief 	Asserts that items of equal priority are received
+     * 			in the order they were sent.
+     */
+    BOOST_AUTO_TEST_CASE(fifo_ties) {
+        using Item = std::pair<int, int>;
+        struct ByPriority {
+                bool operator()(const Item& a, const Item& b) const {
+                    return a.first < b.first;
+                }
+        };
+
+        auto [tx, rx] = piper::make_channel<Item, piper::spmc::Topology,
+                                            flavor::Priority<ByPriority>>();
+        for (int i = 0; i < 20; i++) {
+            tx << Item{i % 2, i};
+        }
+        for (int i = 1; i < 20; i += 2) {
+            BOOST_TEST(rx.recv().second == i);
+        }
+        for (int i = 0; i < 20; i += 2) {
+            BOOST_TEST(rx.recv().second == i);
+        }
+    }
+
+    /**
+     * @test 	buffer_priority/bounded
+     * @brief 	Asserts that a bounded priority channel blocks the
+     * 			sender without losing items.
+     */
+    BOOST_AUTO_TEST_CASE(bounded) {
+        auto [tx, rx] = piper::make_channel<int, piper::mpsc::Topology,
+                                            flavor::Priority<>>(2);
+        std::thread worker(
+            [](auto&& tx) {
+                for (int i = 0; i < 100; i++) {
+                    tx << i;
+                }
+            },
+            std::move(tx));
+
+        int sum = 0;
+        for (int i = 0; i < 100; i++) {
+            sum += rx.recv();
+        }
+        worker.join();
+        BOOST_TEST(sum == 4950);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // buffer_priority
+
+    BOOST_AUTO_TEST_SUITE(buffer_overflow)
+
+    /**
+     * @test 	buffer_overflow/drop_newest
+     * @brief 	Asserts that items sent to a full buffer are
+     * 			discarded and counted.
+     */
+    BOOST_AUTO_TEST_CASE(drop_newest) {
+        auto [tx, rx] =
+            piper::make_channel<int, piper::mpsc::Topology, flavor::Sync>(
+                2, Overflow::drop_newest);
+        for (int i = 0; i < 5; i++) {
+            tx << i;
+        }
+        BOOST_TEST(tx.dropped() == 3);
+        BOOST_TEST(rx.recv() == 0);
+        BOOST_TEST(rx.recv() == 1);
+    }
+
+    /**
+     * @test 	buffer_overflow/drop_oldest
+     * @brief 	Asserts that a full ring is overwritten from its
+     * 			oldest item.
+     */
+    BOOST_AUTO_TEST_CASE(drop_oldest) {
+        auto [tx, rx] = piper::make_channel<int, piper::spmc::Topology,
+                                            flavor::Static<4>>(
+            Overflow::drop_oldest);
+        for (int i = 0; i < 10; i++) {
+            tx << i;
+        }
+        BOOST_TEST(rx.dropped() == 6);
+        for (int i = 6; i < 10; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+    }
+
+    /**
+     * @test 	buffer_overflow/fail
+     * @brief 	Asserts that sending to a full buffer throws
+     * 			without discarding anything.
+     */
+    BOOST_AUTO_TEST_CASE(fail) {
+        auto [tx, rx] =
+            piper::make_channel<int, piper::mpsc::Topology, flavor::Sync>(
+                1, Overflow::fail);
+        tx << 1;
+        BOOST_CHECK_THROW(tx << 2, std::runtime_error);
+        BOOST_TEST(rx.dropped() == 0);
+        BOOST_TEST(rx.recv() == 1);
+    }
+
+    /**
+     * @test 	buffer_overflow/priority
+     * @brief 	Asserts that a full priority buffer keeps the items it
+     * 			would pop first, discarding the lowest priority one.
+     */
+    BOOST_AUTO_TEST_CASE(priority) {
+        auto [tx, rx] = piper::make_channel<int, piper::mpsc::Topology,
+                                            flavor::Priority<>>(
+            4, Overflow::drop_oldest);
+        for (int i : {5, 1, 7, 3, 0, 9, 2, 8}) {
+            tx << i;
+        }
+        BOOST_TEST(rx.dropped() == 4);
+        for (int i : {9, 8, 7, 5}) {
+            BOOST_TEST(rx.recv() == i);
+        }
+        BOOST_TEST(!rx.try_recv());
+
+        auto [full, drain] = piper::make_channel<int, piper::mpsc::Topology,
+                                                 flavor::Priority<>>(
+            1, Overflow::fail);
+        full << 1;
+        BOOST_CHECK_THROW(full << 2, std::runtime_error);
+        BOOST_TEST(drain.recv() == 1);
+    }
+
+    /**
+     * @test 	buffer_overflow/elastic
+     * @brief 	Asserts that an elastic buffer grows to its hard
+     * 			capacity before applying its overflow policy.
+     */
+    BOOST_AUTO_TEST_CASE(elastic) {
+        auto [tx, rx] =
+            piper::make_channel<int, piper::mpsc::Topology, flavor::Elastic>(
+                2, 8, Overflow::drop_oldest);
+        for (int i = 0; i < 12; i++) {
+            tx << i;
+        }
+        BOOST_TEST(rx.dropped() == 4);
+        for (int i = 4; i < 12; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+
+        auto [full, drain] =
+            piper::make_channel<int, piper::mpsc::Topology, flavor::Elastic>(
+                1, 2, Overflow::fail);
+        full << 1 << 2;
+        BOOST_CHECK_THROW(full << 3, std::runtime_error);
+        BOOST_TEST(drain.recv() == 1);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // buffer_overflow
+
+    BOOST_AUTO_TEST_SUITE(buffer_elastic)
+
+    /**
+     * @test 	buffer_elastic/grow_and_shrink
+     * @brief 	Asserts that storage grows up to the hard capacity
+     * 			during a burst, keeps FIFO order, and shrinks back
+     * 			to the soft capacity after draining.
+     */
+    BOOST_AUTO_TEST_CASE(grow_and_shrink) {
+        auto buffer = std::make_shared<piper::internal::ElasticBuffer<int>>(
+            4, 32, 2);
+        piper::mpsc::Receiver<int> rx(buffer);
+        piper::mpsc::Sender<int> tx(rx);
+
+        for (int i = 0; i < 20; i++) {
+            tx << i;
+        }
+        BOOST_TEST(buffer->capacity() == 32);
+
+        for (int i = 0; i < 20; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+        BOOST_TEST(buffer->capacity() == 4);
+    }
+
+    /**
+     * @test 	buffer_elastic/idle
+     * @brief 	Asserts that storage also shrinks after a burst once
+     * 			pushes keep it calm, or once it has lingered long
+     * 			enough, without many more pops.
+     */
+    BOOST_AUTO_TEST_CASE(idle) {
+        using namespace std::chrono_literals;
+        auto buffer = std::make_shared<piper::internal::ElasticBuffer<int>>(
+            4, 32, 4, 1h);
+        piper::mpsc::Receiver<int> rx(buffer);
+        piper::mpsc::Sender<int> tx(rx);
+
+        for (int i = 0; i < 20; i++) {
+            tx << i;
+        }
+        for (int i = 0; i < 18; i++) {
+            rx.recv();
+        }
+        BOOST_TEST(buffer->capacity() == 32);
+        tx << 20;
+        BOOST_TEST(buffer->capacity() == 4);
+        BOOST_TEST(rx.recv() == 18);
+
+        auto lingering =
+            std::make_shared<piper::internal::ElasticBuffer<int>>(
+                4, 32, 1000, 10ms);
+        piper::mpsc::Receiver<int> idle(lingering);
+        piper::mpsc::Sender<int>(idle) << 1 << 2 << 3 << 4 << 5;
+        idle.recv();
+        BOOST_TEST(lingering->capacity() == 8);
+        std::this_thread::sleep_for(20ms);
+        BOOST_TEST(*idle.try_recv() == 2);
+        BOOST_TEST(lingering->capacity() == 4);
+    }
+
+    /**
+     * @test 	buffer_elastic/drained
+     * @brief 	Asserts that storage shrinks once a drained buffer has
+     * 			lingered, while its receiver is blocked waiting.
+     */
+    BOOST_AUTO_TEST_CASE(drained) {
+        using namespace std::chrono_literals;
+        auto buffer = std::make_shared<piper::internal::ElasticBuffer<int>>(
+            4, 32, 1000, 20ms);
+        piper::mpsc::Receiver<int> rx(buffer);
+        piper::mpsc::Sender<int> tx(rx);
+
+        for (int i = 0; i < 20; i++) {
+            tx << i;
+        }
+        BOOST_TEST(buffer->capacity() == 32);
+
+        std::atomic<int> received = 0;
+        std::thread consumer([&] {
+            while (rx.recv() >= 0) {
+                received++;
+            }
+        });
+        while (received < 20) {
+            std::this_thread::sleep_for(1ms);
+        }
+        std::this_thread::sleep_for(100ms);
+        BOOST_TEST(buffer->capacity() == 4);
+
+        tx << -1;
+        consumer.join();
+    }
+
+    /**
+     * @test 	buffer_elastic/hard_capacity
+     * @brief 	Asserts that senders block at the hard capacity
+     * 			without losing items.
+     */
+    BOOST_AUTO_TEST_CASE(hard_capacity) {
+        auto [tx, rx] = piper::make_channel<int, piper::mpsc::Topology,
+                                            flavor::Elastic>(2, 8);
+        std::thread worker(
+            [](auto&& tx) {
+                for (int i = 0; i < 100; i++) {
+                    tx << i;
+                }
+            },
+            std::move(tx));
+        for (int i = 0; i < 100; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+        worker.join();
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // buffer_elastic
+
+    BOOST_AUTO_TEST_SUITE(buffer_spill)
+
+    /**
+     * @test 	buffer_spill/fifo
+     * @brief 	Asserts that items beyond the memory budget spill
+     * 			to disk and are received in FIFO order.
+     */
+    BOOST_AUTO_TEST_CASE(fifo) {
+        using Buffer = piper::internal::SpillBuffer<std::string>;
+        auto buffer = std::make_shared<Buffer>(
+            std::filesystem::temp_directory_path().string(), 8, 256);
+        piper::mpsc::Receiver<std::string> rx(buffer);
+        piper::mpsc::Sender<std::string> tx(rx);
+
+        for (int i = 0; i < 100; i++) {
+            tx << std::to_string(i);
+        }
+        BOOST_TEST(buffer->spilled() == 92);
+
+        // Interleave sends while spilled items remain
+        for (int i = 0; i < 50; i++) {
+            BOOST_TEST(rx.recv() == std::to_string(i));
+        }
+        for (int i = 100; i < 110; i++) {
+            tx << std::to_string(i);
+        }
+        for (int i = 50; i < 110; i++) {
+            BOOST_TEST(rx.recv() == std::to_string(i));
+        }
+        BOOST_TEST(buffer->spilled() == 0);
+        BOOST_TEST(!rx.try_recv());
+
+        // Items stay in memory once the backlog is drained
+        tx << "memory";
+        BOOST_TEST(buffer->spilled() == 0);
+        BOOST_TEST(rx.recv() == "memory");
+    }
+
+    /**
+     * @test 	buffer_spill/threads
+     * @brief 	Asserts that a spilling channel delivers every
+     * 			item across threads.
+     */
+    BOOST_AUTO_TEST_CASE(threads) {
+        auto [tx, rx] =
+            piper::make_channel<std::uint64_t, piper::mpsc::Topology,
+                                flavor::Spill<>>(
+                std::filesystem::temp_directory_path().string(), 16, 4096);
+        std::thread worker(
+            [](auto&& tx) {
+                for (std::uint64_t i = 0; i < 10000; i++) {
+                    tx << i;
+                }
+            },
+            std::move(tx));
+        for (std::uint64_t i = 0; i < 10000; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+        worker.join();
+    }
+
+    /// Fails to decode each odd item once
+    struct Flaky {
+            static inline bool failed = false;
+
+            static void encode(int item, std::vector<std::byte>& out) {
+                piper::Codec<int>::encode(item, out);
+            }
+            static int decode(std::span<const std::byte> in) {
+                auto item = piper::Codec<int>::decode(in);
+                failed = !failed && item % 2;
+                if (failed)
+                    throw std::runtime_error("decode failed");
+                return item;
+            }
+    };
+
+    /**
+     * @test 	buffer_spill/decode_errors
+     * @brief 	Asserts that an item which fails to decode stays
+     * 			in the buffer, so no item is lost.
+     */
+    BOOST_AUTO_TEST_CASE(decode_errors) {
+        piper::internal::SpillBuffer<int, Flaky> buffer(
+            std::filesystem::temp_directory_path().string(), 0, 256);
+        for (int i = 0; i < 6; i++) {
+            buffer.push(i);
+        }
+        BOOST_TEST(buffer.spilled() == 6);
+
+        std::vector<int> items;
+        for (int attempt = 0; attempt < 12; attempt++) {
+            try {
+                if (auto item = buffer.try_pop())
+                    items.push_back(*item);
+            } catch (const std::runtime_error&) {
+            }
+        }
+        BOOST_TEST(items == std::vector<int>({0, 1, 2, 3, 4, 5}));
+        BOOST_TEST(buffer.spilled() == 0);
+    }
+
+    /**
+     * @test 	buffer_spill/no_space
+     * @brief 	Asserts that a segment which cannot be reserved makes
+     * 			push() throw, rather than failing on a later write.
+     */
+    BOOST_AUTO_TEST_CASE(no_space) {
+        // Files may not grow past 1 MiB, as on a nearly full disk
+        rlimit saved;
+        getrlimit(RLIMIT_FSIZE, &saved);
+        auto handler = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit limit = {1 << 20, saved.rlim_max};
+        setrlimit(RLIMIT_FSIZE, &limit);
+
+        piper::internal::SpillBuffer<int> buffer(
+            std::filesystem::temp_directory_path().string(), 0, 1 << 24);
+        BOOST_CHECK_THROW(buffer.push(1), std::system_error);
+
+        setrlimit(RLIMIT_FSIZE, &saved);
+        std::signal(SIGXFSZ, handler);
+        buffer.push(2);
+        BOOST_TEST(buffer.pop() == 2);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // buffer_spill
+
+    BOOST_AUTO_TEST_SUITE(buffer_log)
+
+    /**
+     * @brief 	Creates an empty directory for a log
+     */
+    std::string log_directory(const char* name) {
+        auto path = std::filesystem::temp_directory_path() /
+                    ("piper-" + std::to_string(getpid()) + "-" + name);
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directory(path);
+        return path.string();
+    }
+
+    /**
+     * @test 	buffer_log/replay
+     * @brief 	Asserts that unacknowledged items are replayed when a
+     * 			log is reopened.
+     */
+    BOOST_AUTO_TEST_CASE(replay) {
+        using Buffer = piper::internal::LogBuffer<std::string>;
+        auto directory = log_directory("replay");
+        {
+            auto buffer = std::make_shared<Buffer>(directory);
+            piper::mpsc::Receiver<std::string> rx(buffer);
+            piper::mpsc::Sender<std::string> tx(rx);
+            for (int i = 0; i < 10; i++) {
+                tx << std::to_string(i);
+            }
+            for (int i = 0; i < 4; i++) {
+                BOOST_TEST(rx.recv() == std::to_string(i));
+            }
+        }
+        {
+            // Item 3 was popped but never acknowledged
+            auto buffer = std::make_shared<Buffer>(directory);
+            piper::mpsc::Receiver<std::string> rx(buffer);
+            for (int i = 3; i < 6; i++) {
+                BOOST_TEST(rx.recv() == std::to_string(i));
+            }
+            buffer->acknowledge();
+        }
+        {
+            auto [tx, rx] =
+                piper::make_channel<std::string, piper::mpsc::Topology,
+                                    flavor::Log<>>(directory);
+            tx << "10";
+            for (int i = 6; i < 11; i++) {
+                BOOST_TEST(rx.recv() == std::to_string(i));
+            }
+            BOOST_TEST(!rx.try_recv());
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    /**
+     * @test 	buffer_log/empty
+     * @brief 	Asserts that items encoding to no bytes are delivered
+     * 			and replayed like any other item.
+     */
+    BOOST_AUTO_TEST_CASE(empty) {
+        using Buffer = piper::internal::LogBuffer<std::string>;
+        auto directory = log_directory("empty");
+        {
+            auto buffer = std::make_shared<Buffer>(directory);
+            for (auto item : {"a", "", "c", "", ""}) {
+                buffer->push(item);
+            }
+            BOOST_TEST(buffer->pop() == "a");
+            BOOST_TEST(buffer->pop() == "");
+        }
+        {
+            // The empty item was popped but never acknowledged
+            auto buffer = std::make_shared<Buffer>(directory);
+            buffer->push("f");
+            for (auto item : {"", "c", "", "", "f"}) {
+                BOOST_TEST(buffer->pop() == item);
+            }
+            BOOST_TEST(!buffer->try_pop());
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    /**
+     * @test 	buffer_log/segments
+     * @brief 	Asserts that a log rolls over to new segments and
+     * 			deletes segments once they are acknowledged.
+     */
+    BOOST_AUTO_TEST_CASE(segments) {
+        using Buffer = piper::internal::LogBuffer<std::uint64_t>;
+        auto directory = log_directory("segments");
+        auto count = [&directory] {
+            auto it = std::filesystem::directory_iterator(directory);
+            return std::count_if(begin(it), end(it), [](auto& entry) {
+                return entry.path().extension() == ".log";
+            });
+        };
+        {
+            // Each record takes 16 bytes, so 256 records per segment
+            auto buffer = std::make_shared<Buffer>(directory, 4096, 1);
+            for (std::uint64_t i = 0; i < 1000; i++) {
+                buffer->push(i);
+            }
+            BOOST_TEST(count() == 4);
+            for (std::uint64_t i = 0; i < 600; i++) {
+                BOOST_TEST(buffer->pop() == i);
+            }
+            buffer->acknowledge();
+            BOOST_TEST(count() == 2);
+        }
+        {
+            auto buffer = std::make_shared<Buffer>(directory, 4096, 1);
+            for (std::uint64_t i = 600; i < 1000; i++) {
+                BOOST_TEST(buffer->pop() == i);
+            }
+            BOOST_TEST(!buffer->try_pop());
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    /**
+     * @test 	buffer_log/corrupt
+     * @brief 	Asserts that a record corrupted in the newest segment
+     * 			makes popping throw once, skipping to the tail.
+     */
+    BOOST_AUTO_TEST_CASE(corrupt) {
+        using Buffer = piper::internal::LogBuffer<std::uint64_t>;
+        auto directory = log_directory("corrupt");
+        auto buffer = std::make_shared<Buffer>(directory, 4096, 1);
+        for (std::uint64_t i = 0; i < 3; i++) {
+            buffer->push(i);
+        }
+
+        // Break the checksum of the second record, at offset 16
+        auto segment = directory + "/00000000000000000000.log";
+        auto fd = open(segment.c_str(), O_WRONLY);
+        BOOST_REQUIRE(fd >= 0);
+        std::uint32_t checksum = 0;
+        BOOST_REQUIRE(pwrite(fd, &checksum, sizeof(checksum), 20) ==
+                      sizeof(checksum));
+        close(fd);
+
+        BOOST_TEST(buffer->pop() == 0u);
+        BOOST_CHECK_THROW(buffer->pop(), std::runtime_error);
+        BOOST_TEST(!buffer->try_pop());
+        buffer->push(3);
+        BOOST_TEST(buffer->pop() == 3u);
+        std::filesystem::remove_all(directory);
+    }
+
+    /**
+     * @test 	buffer_log/threads
+     * @brief 	Asserts that a log channel delivers every item
+     * 			across threads.
+     */
+    BOOST_AUTO_TEST_CASE(threads) {
+        auto directory = log_directory("threads");
+        {
+            auto [tx, rx] =
+                piper::make_channel<std::uint64_t, piper::mpsc::Topology,
+                                    flavor::Log<>>(directory, 1 << 16);
+            std::thread worker(
+                [](auto&& tx) {
+                    for (std::uint64_t i = 0; i < 10000; i++) {
+                        tx << i;
+                    }
+                },
+                std::move(tx));
+            for (std::uint64_t i = 0; i < 10000; i++) {
+                BOOST_TEST(rx.recv() == i);
+            }
+            worker.join();
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // buffer_log
+} // namespace piper::tests::buffer
@@ -0,0 +1,163 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		ipc.cpp
+ * @brief		IPC testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+#define BOOST_TEST_MODULE ipc
+#include <boost/test/unit_test.hpp>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "piper/ipc.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::ipc
+ * @brief		Testing suite for IPC channel implementation
+ */
+namespace piper::tests::ipc {
+    struct Sample {
+            std::uint64_t seq;
+            double value;
+    };
+
+    /**
+     * @brief 	Runs a sender in a child process
+     * @param 	fd The file descriptor of the channel segment
+     * @param 	n The number of samples to send
+     * @return 	The process ID of the child
+     */
+    pid_t spawn_sender(int fd, std::uint64_t n) {
+        auto pid = fork();
+        if (pid == 0) {
+            piper::ipc::Sender<Sample> tx(fd);
+            for (std::uint64_t i = 0; i < n; i++) {
+                tx << Sample{i, i * 0.5};
+            }
+            _exit(0);
+        }
+        return pid;
+    }
+
+    BOOST_AUTO_TEST_SUITE(ipc_processes)
+
+    /**
+     * @test 	ipc_processes/two_processes
+     * @brief 	Asserts that a child process can send samples to
+     * 			its parent, in order, through a small ring.
+     */
+    BOOST_AUTO_TEST_CASE(two_processes) {
+        piper::ipc::Channel<Sample> ch(4);
+        auto pid = spawn_sender(ch.fd(), 10000);
+        BOOST_REQUIRE(pid > 0);
+
+        piper::ipc::Receiver<Sample> rx(ch.fd());
+        for (std::uint64_t i = 0; i < 10000; i++) {
+            auto sample = rx.recv();
+            BOOST_TEST(sample.seq == i);
+            BOOST_TEST(sample.value == i * 0.5);
+        }
+
+        int status;
+        waitpid(pid, &status, 0);
+        BOOST_TEST(WIFEXITED(status));
+        BOOST_TEST(WEXITSTATUS(status) == 0);
+    }
+
+    /**
+     * @test 	ipc_processes/huge_pages
+     * @brief 	Asserts that a ring asking for huge pages works
+     * 			whether or not the huge page pool has room.
+     */
+    BOOST_AUTO_TEST_CASE(huge_pages) {
+        using Pages = piper::Placement::Pages;
+        piper::ipc::Channel<Sample> ch(1 << 16,
+                                       piper::Placement{}.with(Pages::huge));
+        auto pid = spawn_sender(ch.fd(), 100000);
+        BOOST_REQUIRE(pid > 0);
+
+        piper::ipc::Receiver<Sample> rx(ch.fd());
+        bool ordered = true;
+        for (std::uint64_t i = 0; i < 100000; i++) {
+            ordered &= rx.recv().seq == i;
+        }
+        BOOST_TEST(ordered);
+
+        int status;
+        waitpid(pid, &status, 0);
+        BOOST_TEST(WEXITSTATUS(status) == 0);
+    }
+
+    /**
+     * @test 	ipc_processes/wraparound
+     * @brief 	Asserts that items keep their order when the ring's
+     * 			counters wrap around, for a size that is not a power
+     * 			of two.
+     */
+    BOOST_AUTO_TEST_CASE(wraparound) {
+        piper::ipc::Channel<int> ch(3);
+
+        // Move both counters to just before the wrap
+        auto length = sizeof(piper::internal::SharedControl);
+        auto address = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                            MAP_SHARED, ch.fd(), 0);
+        BOOST_REQUIRE(address != MAP_FAILED);
+        auto control = static_cast<piper::internal::SharedControl*>(address);
+        control->head.store(0xFFFFFFFE);
+        control->tail.store(0xFFFFFFFE);
+        munmap(address, length);
+
+        for (int round = 0; round < 3; round++) {
+            ch << 1 << 2 << 3;
+            for (int i = 1; i <= 3; i++) {
+                BOOST_TEST(ch.recv() == i);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // ipc_processes
+
+    BOOST_AUTO_TEST_SUITE(ipc_exceptions)
+
+    /**
+     * @test 	ipc_exceptions/mismatch
+     * @brief 	Asserts that attaching to a segment created for
+     * 			another item type throws.
+     */
+    BOOST_AUTO_TEST_CASE(mismatch) {
+        piper::ipc::Channel<Sample> ch(4);
+        BOOST_CHECK_THROW(piper::ipc::Receiver<int>{ch.fd()},
+                          std::runtime_error);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // ipc_exceptions
+} // namespace piper::tests::ipc
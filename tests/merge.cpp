@@ -0,0 +1,145 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		merge.cpp
+ * @brief		Merge testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE merge
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "piper/merge.hpp"
+#include "piper/mpsc.hpp"
+#include "piper/spmc.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::merge
+ * @brief		Testing suite for weighted fair merging
+ */
+namespace piper::tests::merge {
+    using namespace std::chrono_literals;
+
+    BOOST_AUTO_TEST_SUITE(merge)
+
+    /**
+     * @test 	merge/round_robin
+     * @brief 	Asserts that busy inputs are served in turn, in
+     * 			proportion to their weights.
+     */
+    BOOST_AUTO_TEST_CASE(round_robin) {
+        mpsc::Receiver<int> a, b;
+        mpsc::Sender<int> ta(a), tb(b);
+        for (int i = 0; i < 8; i++) {
+            ta << 0;
+            tb << 1;
+        }
+
+        auto rx = piper::merge(piper::weighted(std::move(a), 3),
+                               std::move(b));
+        BOOST_TEST(rx.size() == 2u);
+
+        std::vector<int> order;
+        for (int i = 0; i < 8; i++) {
+            order.push_back(rx.recv());
+        }
+        BOOST_TEST(order == std::vector<int>({0, 0, 0, 1, 0, 0, 0, 1}));
+    }
+
+    /**
+     * @test 	merge/starvation
+     * @brief 	Asserts that an item arriving on a quiet input is taken
+     * 			next, ahead of a backlog on a busy one.
+     */
+    BOOST_AUTO_TEST_CASE(starvation) {
+        mpsc::Receiver<int> a, b;
+        mpsc::Sender<int> ta(a), tb(b);
+        for (int i = 0; i < 1000; i++) {
+            ta << 0;
+        }
+
+        auto rx = piper::merge(std::move(a), std::move(b));
+        BOOST_TEST(rx.recv() == 0);
+        BOOST_TEST(rx.recv() == 0);
+
+        tb << 1;
+        BOOST_TEST(rx.recv() == 1);
+        BOOST_TEST(rx.recv() == 0);
+    }
+
+    /**
+     * @test 	merge/blocking
+     * @brief 	Asserts that receiving waits on every input at once.
+     */
+    BOOST_AUTO_TEST_CASE(blocking) {
+        mpsc::Receiver<int> a, b, c;
+        mpsc::Sender<int> tc(c);
+        auto rx = piper::merge(std::move(a), std::move(b), std::move(c));
+        BOOST_TEST(!rx.try_recv());
+
+        std::thread sender([&] {
+            std::this_thread::sleep_for(20ms);
+            tc << 42;
+        });
+        BOOST_TEST(rx.recv() == 42);
+        sender.join();
+    }
+
+    /**
+     * @test 	merge/expiry
+     * @brief 	Asserts that expired inputs are skipped, and that
+     * 			receiving throws once every input has expired.
+     */
+    BOOST_AUTO_TEST_CASE(expiry) {
+        auto ta = std::make_unique<spmc::Sender<int>>();
+        auto tb = std::make_unique<spmc::Sender<int>>();
+        auto rx = piper::merge(spmc::Receiver<int>(*ta),
+                               spmc::Receiver<int>(*tb));
+
+        ta.reset();
+        *tb << 7;
+        BOOST_TEST(rx.recv() == 7);
+
+        std::thread closer([&] {
+            std::this_thread::sleep_for(20ms);
+            tb.reset();
+        });
+        BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+        closer.join();
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // merge
+} // namespace piper::tests::merge
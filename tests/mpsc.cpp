@@ -34,7 +34,10 @@
 #define BOOST_TEST_MODULE mpsc
 #include <boost/test/unit_test.hpp>
 
+#include "piper/factory.hpp"
+#include "piper/internal/sharded.hpp"
 #include "piper/mpsc.hpp"
+#include "piper/stage.hpp"
 #include "tests.hpp"
 
 /**
@@ -64,6 +67,25 @@ namespace piper::tests::mpsc {
         }
     }
 
+    /// A receiver written before try_recv() was added
+    struct Counting : piper::Receiver<int> {
+            int next = 0;
+            int recv() override { return next++; }
+    };
+
+    /**
+     * @test 	mpsc_exceptions/unpollable
+     * @brief 	Asserts that a receiver without try_recv() still
+     * 			receives, and throws when polled.
+     */
+    BOOST_AUTO_TEST_CASE(unpollable) {
+        Counting rx;
+        int item;
+        rx >> item >> item;
+        BOOST_TEST(item == 1);
+        BOOST_CHECK_THROW(rx.try_recv(), std::logic_error);
+    }
+
     BOOST_AUTO_TEST_SUITE_END() // mpsc_exceptions
 
     BOOST_AUTO_TEST_SUITE(mpsc_async)
@@ -88,7 +110,7 @@ namespace piper::tests::mpsc {
             },
             std::move(Sender{*rx}));
         for (int i = 0; i < 5; i++) {
-            BOOST_TEST(rx->recv() == 1);
+            BOOST_TEST(rx->recv() == i);
         }
         worker.join();
     }
@@ -113,4 +135,217 @@ namespace piper::tests::mpsc {
     }
 
     BOOST_AUTO_TEST_SUITE_END() // mpsc_async
+
+    BOOST_AUTO_TEST_SUITE(mpsc_factory)
+
+    /**
+     * @test mpsc_factory/make_channel
+     * @brief Asserts that a sender and receiver returned by
+     * 		  make_channel are connected over a bounded buffer.
+     */
+    BOOST_AUTO_TEST_CASE(make_channel) {
+        auto [tx, rx] =
+            piper::make_channel<int, piper::mpsc::Topology, flavor::Sync>(2);
+        std::thread worker(
+            [](auto&& tx) {
+                for (int i = 0; i < 5; i++) {
+                    tx << i;
+                }
+            },
+            std::move(tx));
+        for (int i = 0; i < 5; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+        worker.join();
+    }
+
+    /**
+     * @test mpsc_factory/channel
+     * @brief Asserts that a Channel can send to itself.
+     */
+    BOOST_AUTO_TEST_CASE(channel) {
+        piper::mpsc::Channel<int> ch(1);
+        ch << 1;
+        BOOST_TEST(ch.recv() == 1);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // mpsc_factory
+
+    BOOST_AUTO_TEST_SUITE(mpsc_sharded)
+
+    /**
+     * @test mpsc_sharded/producers
+     * @brief Asserts that items from many senders, each on its own
+     * 		  lane, all arrive in per-sender order.
+     */
+    BOOST_AUTO_TEST_CASE(producers) {
+        constexpr int senders = 8, count = 20000;
+        auto [tx, rx] = piper::make_channel<std::pair<int, int>,
+                                            piper::mpsc::Topology,
+                                            flavor::Sharded>(16);
+
+        std::vector<std::thread> workers;
+        for (int s = 0; s < senders; s++) {
+            workers.emplace_back(
+                [s](auto tx) {
+                    for (int i = 0; i < count; i++) {
+                        tx << std::pair{s, i};
+                    }
+                },
+                piper::mpsc::Sender<std::pair<int, int>>(rx));
+        }
+
+        std::vector<int> expected(senders, 0);
+        bool ordered = true;
+        for (int i = 0; i < senders * count; i++) {
+            auto [s, n] = rx.recv();
+            ordered &= n == expected[s]++;
+        }
+        BOOST_TEST(ordered);
+        BOOST_TEST(!rx.try_recv());
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @test mpsc_sharded/lanes
+     * @brief Asserts that a sender's items outlive the sender, and
+     * 		  that senders fail once the receiver is gone.
+     */
+    BOOST_AUTO_TEST_CASE(lanes) {
+        auto buffer = std::make_shared<piper::internal::ShardedBuffer<int>>(4);
+        auto rx = std::make_unique<Receiver>(buffer);
+        {
+            Sender tx(*rx);
+            tx << 1 << 2;
+        }
+        buffer->push(3);
+        buffer.reset();
+
+        // Lanes are polled round-robin
+        std::vector<int> items(3);
+        std::generate(items.begin(), items.end(), [&] { return rx->recv(); });
+        std::sort(items.begin(), items.end());
+        BOOST_TEST(items == std::vector<int>({1, 2, 3}));
+        BOOST_TEST(!rx->try_recv());
+
+        Sender tx(*rx);
+        rx.reset();
+        BOOST_CHECK_THROW(tx << 4, std::runtime_error);
+    }
+
+    /**
+     * @test mpsc_sharded/placement
+     * @brief Asserts that lanes placed on a node, or interleaved
+     * 		  across nodes, behave like ordinary lanes.
+     */
+    BOOST_AUTO_TEST_CASE(placement) {
+        for (auto placement : {piper::Placement::local(),
+                               piper::Placement::interleaved()}) {
+            auto [tx, rx] =
+                piper::make_channel<int, piper::mpsc::Topology,
+                                    flavor::Sharded>(4096, placement);
+
+            std::thread producer([tx = Sender(rx)]() mutable {
+                for (int i = 0; i < 100000; i++) {
+                    tx << i;
+                }
+            });
+
+            bool ordered = true;
+            for (int i = 0; i < 100000; i++) {
+                ordered &= rx.recv() == i;
+            }
+            BOOST_TEST(ordered);
+            producer.join();
+        }
+    }
+
+    /**
+     * @test mpsc_sharded/pages
+     * @brief Asserts that lane storage asking for larger pages falls
+     * 		  back gracefully, and is aligned to the pages it gets.
+     */
+    BOOST_AUTO_TEST_CASE(pages) {
+        using Pages = piper::Placement::Pages;
+        auto huge = piper::Placement::huge_page_size();
+        for (auto pages : {Pages::normal, Pages::transparent, Pages::huge}) {
+            piper::internal::PlacedArray<std::uint64_t> array(
+                1 << 20, piper::Placement{}.with(pages));
+            BOOST_TEST(array[0] == 0u);
+            BOOST_TEST(array[(1 << 20) - 1] == 0u);
+            array[12345] = 42;
+            BOOST_TEST(array[12345] == 42u);
+
+            BOOST_TEST((array.pages() <= pages));
+            if (array.pages() != Pages::normal) {
+                auto address = reinterpret_cast<std::uintptr_t>(&array[0]);
+                BOOST_TEST(address % huge == 0u);
+            }
+        }
+
+        auto [tx, rx] = piper::make_channel<int, piper::mpsc::Topology,
+                                            flavor::Sharded>(
+            1 << 20, piper::Placement{}.with(Pages::transparent));
+        std::thread producer([tx = Sender(rx)]() mutable {
+            for (int i = 0; i < 100000; i++) {
+                tx << i;
+            }
+        });
+        bool ordered = true;
+        for (int i = 0; i < 100000; i++) {
+            ordered &= rx.recv() == i;
+        }
+        BOOST_TEST(ordered);
+        producer.join();
+    }
+
+    /// Counts readiness transitions
+    struct Counter final : piper::internal::Listener {
+            std::atomic<int> fills{0}, drains{0};
+            void filled() override { fills++; }
+            void drained() override { drains++; }
+    };
+
+    /**
+     * @test mpsc_sharded/listen
+     * @brief Asserts that a listener hears each empty to non-empty
+     * 		  transition of a sharded buffer, and that a stage over
+     * 		  one wakes for items sent while it waits.
+     */
+    BOOST_AUTO_TEST_CASE(listen) {
+        auto [tx, rx] = piper::make_channel<int, piper::mpsc::Topology,
+                                            flavor::Sharded>(16);
+        auto counter = std::make_shared<Counter>();
+        rx.listen(counter);
+        BOOST_TEST(counter->fills == 0);
+
+        tx << 1 << 2;
+        BOOST_TEST(counter->fills == 1);
+        BOOST_TEST(*rx.try_recv() == 1);
+        BOOST_TEST(*rx.try_recv() == 2);
+        BOOST_TEST(!rx.try_recv());
+        BOOST_TEST(counter->drains == 1);
+        Sender(rx) << 3;
+        BOOST_TEST(counter->fills == 2);
+        rx.listen(nullptr);
+
+        Receiver sink;
+        piper::Stage stage(std::move(rx), Sender(sink),
+                           [](int x) { return x; });
+        for (int i = 0; i < 10; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            tx << i;
+        }
+        BOOST_TEST(sink.recv() == 3);
+        bool ordered = true;
+        for (int i = 0; i < 10; i++) {
+            ordered &= sink.recv() == i;
+        }
+        BOOST_TEST(ordered);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // mpsc_sharded
 } // namespace piper::tests::mpsc
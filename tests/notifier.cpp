@@ -0,0 +1,159 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		notifier.cpp
+ * @brief		Notifier testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+#define BOOST_TEST_MODULE notifier
+#include <boost/test/unit_test.hpp>
+
+#include <poll.h>
+#include <sys/epoll.h>
+
+#include "piper/mpsc.hpp"
+#include "piper/notifier.hpp"
+#include "piper/spmc.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::notifier
+ * @brief		Testing suite for Notifier implementation
+ */
+namespace piper::tests::notifier {
+    /**
+     * @brief 	Checks whether a descriptor is readable
+     * @param 	fd The descriptor to poll
+     * @return 	Whether fd is readable, without blocking
+     */
+    bool readable(int fd) {
+        pollfd entry{fd, POLLIN, 0};
+        return poll(&entry, 1, 0) == 1 && (entry.revents & POLLIN);
+    }
+
+    BOOST_AUTO_TEST_SUITE(notifier_readiness)
+
+    /**
+     * @test 	notifier_readiness/transitions
+     * @brief 	Asserts that the descriptor is readable exactly
+     * 			while the channel holds items.
+     */
+    BOOST_AUTO_TEST_CASE(transitions) {
+        auto notifier = std::make_shared<piper::Notifier>();
+        piper::mpsc::Receiver<int> rx;
+        piper::mpsc::Sender<int> tx(rx);
+        rx.listen(notifier);
+
+        BOOST_TEST(!readable(notifier->fd()));
+        tx << 1 << 2 << 3;
+        BOOST_TEST(readable(notifier->fd()));
+
+        BOOST_TEST(*rx.try_recv() == 1);
+        BOOST_TEST(readable(notifier->fd()));
+        BOOST_TEST(*rx.try_recv() == 2);
+        BOOST_TEST(*rx.try_recv() == 3);
+        BOOST_TEST(!readable(notifier->fd()));
+        BOOST_TEST(!rx.try_recv());
+    }
+
+    /**
+     * @test 	notifier_readiness/coalesced
+     * @brief 	Asserts that a burst of items signals the
+     * 			descriptor once.
+     */
+    BOOST_AUTO_TEST_CASE(coalesced) {
+        auto notifier = std::make_shared<piper::Notifier>();
+        piper::spmc::Sender<int> tx(8);
+        piper::spmc::Receiver<int> rx(tx);
+        rx.listen(notifier);
+
+        for (int i = 0; i < 5; i++) {
+            tx << i;
+        }
+        std::uint64_t count = 0;
+        BOOST_TEST(read(notifier->fd(), &count, sizeof(count)) ==
+                   sizeof(count));
+        BOOST_TEST(count == 1);
+    }
+
+    /**
+     * @test 	notifier_readiness/already_filled
+     * @brief 	Asserts that attaching to a non-empty channel
+     * 			signals the descriptor.
+     */
+    BOOST_AUTO_TEST_CASE(already_filled) {
+        piper::mpsc::Receiver<int> rx(4);
+        piper::mpsc::Sender<int> tx(rx);
+        tx << 1;
+
+        auto notifier = std::make_shared<piper::Notifier>();
+        rx.listen(notifier);
+        BOOST_TEST(readable(notifier->fd()));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // notifier_readiness
+
+    BOOST_AUTO_TEST_SUITE(notifier_epoll)
+
+    /**
+     * @test 	notifier_epoll/event_loop
+     * @brief 	Asserts that an epoll loop can receive every item
+     * 			sent by another thread.
+     */
+    BOOST_AUTO_TEST_CASE(event_loop) {
+        auto notifier = std::make_shared<piper::Notifier>();
+        piper::mpsc::Receiver<int> rx;
+        rx.listen(notifier);
+
+        int epoll = epoll_create1(0);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, notifier->fd(), &event);
+
+        std::thread worker(
+            [](auto&& tx) {
+                for (int i = 0; i < 1000; i++) {
+                    tx << i;
+                }
+            },
+            piper::mpsc::Sender<int>{rx});
+
+        int expected = 0;
+        while (expected < 1000) {
+            BOOST_REQUIRE(epoll_wait(epoll, &event, 1, 1000) == 1);
+            while (auto item = rx.try_recv()) {
+                BOOST_TEST(*item == expected++);
+            }
+        }
+        worker.join();
+        close(epoll);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // notifier_epoll
+} // namespace piper::tests::notifier
@@ -0,0 +1,146 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		oneshot.cpp
+ * @brief		Oneshot channel testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE oneshot
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "piper/oneshot.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::oneshot
+ * @brief		Testing suite for oneshot channel implementation
+ */
+namespace piper::tests::oneshot {
+    /**
+     * @brief 	Counts live instances, to check values are destroyed
+     */
+    struct Counted {
+            static inline std::atomic<int> live = 0;
+            Counted() { live++; }
+            Counted(const Counted&) { live++; }
+            ~Counted() { live--; }
+    };
+
+    BOOST_AUTO_TEST_SUITE(oneshot_channel)
+
+    /**
+     * @test 	oneshot_channel/reply
+     * @brief 	Asserts that a value sent from another thread is
+     * 			received exactly once.
+     */
+    BOOST_AUTO_TEST_CASE(reply) {
+        auto [tx, rx] = piper::oneshot::channel<std::string>();
+        std::thread worker([tx = std::move(tx)]() mutable { tx << "reply"; });
+        BOOST_TEST(rx.recv() == "reply");
+        BOOST_CHECK_THROW(rx.recv(), std::logic_error);
+        worker.join();
+    }
+
+    /**
+     * @test 	oneshot_channel/try_recv
+     * @brief 	Asserts that try_recv returns nothing until the value
+     * 			is sent, and that a value can only be sent once.
+     */
+    BOOST_AUTO_TEST_CASE(try_recv) {
+        auto [tx, rx] = piper::oneshot::channel<std::unique_ptr<int>>();
+        BOOST_TEST(!rx.try_recv());
+        tx.send(std::make_unique<int>(42));
+        BOOST_CHECK_THROW(tx.send(std::make_unique<int>(0)), std::logic_error);
+        BOOST_TEST(**rx.try_recv() == 42);
+    }
+
+    /**
+     * @test 	oneshot_channel/dropped
+     * @brief 	Asserts that dropping either end is detected by the
+     * 			other.
+     */
+    BOOST_AUTO_TEST_CASE(dropped) {
+        {
+            auto [tx, rx] = piper::oneshot::channel<int>();
+            std::thread worker([tx = std::move(tx)] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            });
+            BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+            worker.join();
+        }
+        {
+            auto [tx, rx] = piper::oneshot::channel<int>();
+            { auto gone = std::move(rx); }
+            BOOST_CHECK_THROW(tx.send(1), std::runtime_error);
+        }
+        {
+            // An unreceived value is destroyed with the channel
+            auto [tx, rx] = piper::oneshot::channel<Counted>();
+            tx.send(Counted());
+            BOOST_TEST(Counted::live == 1);
+        }
+        BOOST_TEST(Counted::live == 0);
+    }
+
+    /**
+     * @test 	oneshot_channel/stress
+     * @brief 	Asserts that many channels answered concurrently each
+     * 			deliver their value.
+     */
+    BOOST_AUTO_TEST_CASE(stress) {
+        constexpr int count = 100000;
+        std::vector<piper::oneshot::Sender<int>> senders;
+        std::vector<piper::oneshot::Receiver<int>> receivers;
+        for (int i = 0; i < count; i++) {
+            auto [tx, rx] = piper::oneshot::channel<int>();
+            senders.push_back(std::move(tx));
+            receivers.push_back(std::move(rx));
+        }
+
+        std::thread worker([&senders] {
+            for (int i = 0; i < count; i++) {
+                senders[i] << i;
+            }
+        });
+        bool ok = true;
+        for (int i = 0; i < count; i++) {
+            ok &= receivers[i].recv() == i;
+        }
+        worker.join();
+        BOOST_TEST(ok);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // oneshot_channel
+} // namespace piper::tests::oneshot
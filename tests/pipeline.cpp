@@ -0,0 +1,416 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		pipeline.cpp
+ * @brief		Pipeline operator testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE pipeline
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "piper/merge.hpp"
+#include "piper/mpsc.hpp"
+#include "piper/pipeline.hpp"
+#include "piper/spmc.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::pipeline
+ * @brief		Testing suite for pipeline operators
+ */
+namespace piper::tests::pipeline {
+    BOOST_AUTO_TEST_SUITE(pipeline_operators)
+
+    /**
+     * @test 	pipeline_operators/fused
+     * @brief 	Asserts that adjacent operators run in one stage, in
+     * 			order.
+     */
+    BOOST_AUTO_TEST_CASE(fused) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        mpsc::Receiver<std::string> sink;
+
+        auto pipeline =
+            std::move(source) | piper::map([](int x) { return x * 2; }) |
+            piper::filter([](int x) { return x % 3 == 0; }) |
+            piper::flat_map([](int x) {
+                return std::vector<std::string>{std::to_string(x), "."};
+            }) |
+            mpsc::Sender<std::string>(sink);
+        BOOST_TEST(pipeline.size() == 1u);
+
+        for (int i = 0; i < 10; i++) {
+            tx << i;
+        }
+        std::string joined;
+        for (int i = 0; i < 8; i++) {
+            joined += sink.recv();
+        }
+        BOOST_TEST(joined == "0.6.12.18.");
+
+        pipeline.stop();
+        pipeline.join();
+        BOOST_TEST(!sink.try_recv());
+    }
+
+    /**
+     * @test 	pipeline_operators/spawned
+     * @brief 	Asserts that an operator given options starts a new
+     * 			stage, that every item crosses the link in order, and
+     * 			that the stages finish once their source expires.
+     */
+    BOOST_AUTO_TEST_CASE(spawned) {
+        auto source = std::make_unique<spmc::Sender<int>>();
+        mpsc::Receiver<int> sink;
+
+        auto pipeline =
+            spmc::Receiver<int>(*source) |
+            piper::map([](int x) { return x + 1; }, {.name = "first"}) |
+            piper::map([](int x) { return x * 10; }, {.name = "second"}) |
+            piper::filter([](int x) { return x != 50; }) |
+            piper::for_each(
+                [tx = mpsc::Sender<int>(sink)](int x) mutable { tx << x; });
+        BOOST_TEST(pipeline.size() == 2u);
+
+        for (int i = 0; i < 5000; i++) {
+            *source << i;
+        }
+        bool ordered = true;
+        for (int i = 1; i <= 5000; i++) {
+            if (i != 5)
+                ordered &= sink.recv() == i * 10;
+        }
+        BOOST_TEST(ordered);
+
+        source.reset();
+        pipeline.join();
+        BOOST_TEST(!sink.try_recv());
+    }
+
+    /**
+     * @test 	pipeline_operators/stop
+     * @brief 	Asserts that stopping a pipeline whose source never
+     * 			expires still delivers the items inside it.
+     */
+    BOOST_AUTO_TEST_CASE(stop) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        std::mutex mutex;
+        int count = 0;
+
+        auto pipeline =
+            std::move(source) | piper::map([](int x) { return x; }) |
+            piper::for_each(
+                [&](int) {
+                    auto lock = std::unique_lock(mutex);
+                    count++;
+                },
+                {.name = "sink"});
+        BOOST_TEST(pipeline.size() == 2u);
+
+        for (int i = 0; i < 100; i++) {
+            tx << i;
+        }
+        while (true) {
+            auto lock = std::unique_lock(mutex);
+            if (count == 100)
+                break;
+        }
+        pipeline.stop();
+        pipeline.join();
+        BOOST_TEST(count == 100);
+    }
+
+    /**
+     * @test 	pipeline_operators/errors
+     * @brief 	Asserts that an exception thrown by an operator reaches
+     * 			join().
+     */
+    BOOST_AUTO_TEST_CASE(errors) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        auto pipeline = std::move(source) |
+                        piper::map([](int x) {
+                            if (x == 3)
+                                throw std::logic_error("bad item");
+                            return x;
+                        }) |
+                        piper::for_each([](int) {}, {.name = "sink"});
+
+        for (int i = 0; i < 5; i++) {
+            tx << i;
+        }
+        BOOST_CHECK_THROW(pipeline.join(), std::logic_error);
+    }
+
+    /**
+     * @test 	pipeline_operators/sink_errors
+     * @brief 	Asserts that an exception thrown by a spawned sink
+     * 			ends the stages before it, and reaches join().
+     */
+    BOOST_AUTO_TEST_CASE(sink_errors) {
+        using namespace std::chrono_literals;
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        auto pipeline = std::make_shared<piper::Pipeline>(
+            std::move(source) | piper::map([](int x) { return x; }) |
+            piper::for_each(
+                [](int x) {
+                    if (x == 3)
+                        throw std::logic_error("bad item");
+                },
+                {.name = "sink"}));
+
+        for (int i = 0; i < 5; i++) {
+            tx << i;
+        }
+
+        auto joined = std::make_shared<std::atomic<int>>(0);
+        std::thread joiner([pipeline, joined] {
+            try {
+                pipeline->join();
+                *joined = 1;
+            } catch (const std::logic_error&) {
+                *joined = 2;
+            }
+        });
+        auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (!*joined && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        BOOST_TEST(*joined == 2);
+        if (*joined)
+            joiner.join();
+        else
+            joiner.detach();
+    }
+
+    /**
+     * @test 	pipeline_operators/parallel
+     * @brief 	Asserts that a parallel map spreads items over its
+     * 			workers and hands them on in their original order.
+     */
+    BOOST_AUTO_TEST_CASE(parallel) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        mpsc::Receiver<int> sink;
+        std::mutex mutex;
+        std::set<std::thread::id> threads;
+
+        auto pipeline =
+            std::move(source) |
+            piper::parallel_map(
+                [&](int x) {
+                    {
+                        auto lock = std::unique_lock(mutex);
+                        threads.insert(std::this_thread::get_id());
+                    }
+                    // Uneven work, so results complete out of order
+                    std::this_thread::sleep_for(
+                        std::chrono::microseconds((x * 7919) % 50));
+                    return x * 2;
+                },
+                4, 16, {.name = "worker"}) |
+            piper::map([](int x) { return x + 1; }) |
+            mpsc::Sender<int>(sink);
+        BOOST_TEST(pipeline.size() == 6u);
+
+        for (int i = 0; i < 2000; i++) {
+            tx << i;
+        }
+        bool ordered = true;
+        for (int i = 0; i < 2000; i++) {
+            ordered &= sink.recv() == i * 2 + 1;
+        }
+        BOOST_TEST(ordered);
+        BOOST_TEST(threads.size() > 1u);
+
+        pipeline.stop();
+        pipeline.join();
+    }
+
+    /**
+     * @test 	pipeline_operators/parallel_errors
+     * @brief 	Asserts that an item failing in a parallel map is
+     * 			skipped without stopping its worker, and that its
+     * 			exception reaches join().
+     */
+    BOOST_AUTO_TEST_CASE(parallel_errors) {
+        for (std::size_t workers : {1, 2}) {
+            mpsc::Receiver<int> source;
+            mpsc::Sender<int> tx(source);
+            mpsc::Receiver<int> sink;
+
+            auto pipeline = std::move(source) |
+                            piper::parallel_map(
+                                [](int x) {
+                                    if (x % 10 == 5)
+                                        throw std::logic_error("bad item");
+                                    return x;
+                                },
+                                workers, 4) |
+                            mpsc::Sender<int>(sink);
+
+            for (int i = 0; i < 100; i++) {
+                tx << i;
+            }
+            bool ordered = true;
+            for (int i = 0; i < 100; i++) {
+                if (i % 10 != 5)
+                    ordered &= sink.recv() == i;
+            }
+            BOOST_TEST(ordered);
+
+            pipeline.stop();
+            BOOST_CHECK_THROW(pipeline.join(), std::logic_error);
+        }
+    }
+
+    /**
+     * @test 	pipeline_operators/batched
+     * @brief 	Asserts that a batching operator hands whole batches to
+     * 			the next stage, and flushes the rest once overdue.
+     */
+    BOOST_AUTO_TEST_CASE(batched) {
+        using namespace std::chrono_literals;
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        mpsc::Receiver<std::size_t> sizes;
+
+        auto pipeline =
+            std::move(source) | piper::batch(8, 200ms) |
+            piper::map([](std::vector<int> batch) { return batch.size(); }) |
+            mpsc::Sender<std::size_t>(sizes);
+        BOOST_TEST(pipeline.size() == 2u);
+
+        for (int i = 0; i < 20; i++) {
+            tx << i;
+        }
+        BOOST_TEST(sizes.recv() == 8u);
+        BOOST_TEST(sizes.recv() == 8u);
+        BOOST_TEST(sizes.recv() == 4u);
+    }
+
+    /**
+     * @test 	pipeline_operators/rate_limited
+     * @brief 	Asserts that a rate-limiting operator paces the items
+     * 			passed to the rest of the stage.
+     */
+    BOOST_AUTO_TEST_CASE(rate_limited) {
+        using Clock = std::chrono::steady_clock;
+        using namespace std::chrono_literals;
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        mpsc::Receiver<int> sink;
+
+        auto pipeline = std::move(source) | piper::rate_limit(500, 1) |
+                        piper::map([](int i) { return i * 2; }) |
+                        mpsc::Sender<int>(sink);
+        BOOST_TEST(pipeline.size() == 1u);
+
+        for (int i = 0; i < 51; i++) {
+            tx << i;
+        }
+        auto start = Clock::now();
+        for (int i = 0; i < 51; i++) {
+            BOOST_TEST(sink.recv() == i * 2);
+        }
+        auto elapsed = Clock::now() - start;
+        BOOST_TEST((elapsed >= 90ms && elapsed < 1s));
+    }
+
+    /**
+     * @test 	pipeline_operators/merged
+     * @brief 	Asserts that a merge of several inputs can start a
+     * 			pipeline, which still stops on request.
+     */
+    BOOST_AUTO_TEST_CASE(merged) {
+        mpsc::Receiver<int> a, b;
+        mpsc::Sender<int> ta(a), tb(b);
+        mpsc::Receiver<int> sink;
+
+        auto pipeline = piper::merge(std::move(a), std::move(b)) |
+                        piper::map([](int i) { return i + 1; }) |
+                        mpsc::Sender<int>(sink);
+
+        ta << 1;
+        BOOST_TEST(sink.recv() == 2);
+        tb << 2;
+        BOOST_TEST(sink.recv() == 3);
+
+        pipeline.stop();
+        pipeline.join();
+    }
+
+    /**
+     * @test 	pipeline_operators/windowed
+     * @brief 	Asserts that a windowing operator hands aggregates to
+     * 			the next stage, and flushes open windows on shutdown.
+     */
+    BOOST_AUTO_TEST_CASE(windowed) {
+        using namespace std::chrono_literals;
+        using Event = std::pair<std::chrono::milliseconds, int>;
+        mpsc::Receiver<Event> source;
+        mpsc::Sender<Event> tx(source);
+        mpsc::Receiver<int> sums;
+
+        auto pipeline =
+            std::move(source) |
+            piper::window(piper::tumbling(1s),
+                          piper::reducer(0, std::plus<>(),
+                                         [](const Event& e) {
+                                             return e.second;
+                                         }),
+                          piper::event_time(
+                              [](const Event& e) { return e.first; })) |
+            piper::map([](piper::Window<int> w) { return w.value; }) |
+            mpsc::Sender<int>(sums);
+
+        tx << Event(0ms, 1) << Event(500ms, 2) << Event(1500ms, 4);
+        BOOST_TEST(sums.recv() == 3);
+
+        pipeline.stop();
+        pipeline.join();
+        BOOST_TEST(sums.recv() == 4);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // pipeline_operators
+} // namespace piper::tests::pipeline
@@ -0,0 +1,145 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		pool.cpp
+ * @brief		Pool testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+#define BOOST_TEST_MODULE pool
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "piper/mpsc.hpp"
+#include "piper/pool.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::pool
+ * @brief		Testing suite for Pool implementation
+ */
+namespace piper::tests::pool {
+    using Pool = piper::Pool<std::vector<int>>;
+
+    BOOST_AUTO_TEST_SUITE(pool_bounds)
+
+    /**
+     * @test 	pool_bounds/exhausted
+     * @brief 	Asserts that try_acquire() fails once every item
+     * 			is in use, and succeeds again after a release.
+     */
+    BOOST_AUTO_TEST_CASE(exhausted) {
+        Pool pool(2);
+        auto a = pool.try_acquire();
+        auto b = pool.try_acquire();
+        BOOST_TEST(bool(a));
+        BOOST_TEST(bool(b));
+        BOOST_TEST(!pool.try_acquire());
+
+        auto address = a.get();
+        a.reset();
+        auto c = pool.try_acquire();
+        BOOST_TEST(c.get() == address);
+    }
+
+    /**
+     * @test 	pool_bounds/overflow
+     * @brief 	Asserts that acquire() allocates once the pool
+     * 			is exhausted.
+     */
+    BOOST_AUTO_TEST_CASE(overflow) {
+        Pool pool(1);
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        BOOST_TEST(bool(b));
+        BOOST_TEST(a.get() != b.get());
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // pool_bounds
+
+    BOOST_AUTO_TEST_SUITE(pool_recycling)
+
+    /**
+     * @test 	pool_recycling/channel
+     * @brief 	Asserts that items released by a receiver are
+     * 			recycled for the sender.
+     */
+    BOOST_AUTO_TEST_CASE(channel) {
+        Pool pool(4);
+        piper::mpsc::Receiver<Pool::Handle> rx(4);
+
+        std::thread worker(
+            [pool](auto&& tx) mutable {
+                for (int i = 0; i < 1000; i++) {
+                    auto item = pool.acquire();
+                    item->assign(1, i);
+                    tx << std::move(item);
+                }
+            },
+            piper::mpsc::Sender<Pool::Handle>{rx});
+
+        for (int i = 0; i < 1000; i++) {
+            auto item = rx.recv();
+            BOOST_TEST(item->front() == i);
+        }
+        worker.join();
+
+        // Every handle came back, and no more exist
+        std::vector<Pool::Handle> held;
+        for (int i = 0; i < 4; i++) {
+            auto item = pool.try_acquire();
+            BOOST_TEST(bool(item));
+            held.push_back(std::move(item));
+        }
+        BOOST_TEST(!pool.try_acquire());
+    }
+
+    /// Checks whether a buffer of T accepts an item to copy
+    template <typename T>
+    constexpr bool copies = requires(piper::internal::Buffer<T>& buffer,
+                                     const T& item) { buffer.push(item); };
+
+    /**
+     * @test 	pool_recycling/move_only
+     * @brief 	Asserts that handles, which cannot be copied, can only
+     * 			be moved into a buffer.
+     */
+    BOOST_AUTO_TEST_CASE(move_only) {
+        static_assert(!copies<Pool::Handle>);
+        static_assert(copies<std::vector<int>>);
+
+        piper::mpsc::Receiver<Pool::Handle> rx(1);
+        piper::mpsc::Sender<Pool::Handle> tx(rx);
+        const auto item = Pool(1).acquire();
+        BOOST_CHECK_THROW(tx.send(item), std::logic_error);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // pool_recycling
+} // namespace piper::tests::pool
@@ -0,0 +1,144 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		rate.cpp
+ * @brief		Rate limiting testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE rate
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "piper/mpsc.hpp"
+#include "piper/rate.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::rate
+ * @brief		Testing suite for token-bucket rate limiting
+ */
+namespace piper::tests::rate {
+    using namespace std::chrono_literals;
+    using Clock = std::chrono::steady_clock;
+
+    BOOST_AUTO_TEST_SUITE(token_bucket)
+
+    /**
+     * @test 	token_bucket/burst
+     * @brief 	Asserts that a full bucket hands out its burst at once,
+     * 			and nothing more until it refills.
+     */
+    BOOST_AUTO_TEST_CASE(burst) {
+        piper::TokenBucket bucket(10, 4);
+        BOOST_TEST(bucket.burst() == 4u);
+        BOOST_TEST(bucket.rate() == 10.0);
+
+        BOOST_TEST(bucket.try_acquire(3) == 3u);
+        BOOST_TEST(bucket.try_acquire(3) == 1u);
+        BOOST_TEST(bucket.try_acquire() == 0u);
+        BOOST_CHECK_THROW(piper::TokenBucket(0), std::logic_error);
+    }
+
+    /**
+     * @test 	token_bucket/refill
+     * @brief 	Asserts that an empty bucket paces acquisitions at its
+     * 			rate, a batch per wakeup.
+     */
+    BOOST_AUTO_TEST_CASE(refill) {
+        piper::TokenBucket bucket(200, 5);
+
+        // Start before draining the bucket, since it refills from then
+        auto start = Clock::now();
+        BOOST_TEST(bucket.acquire(5) == 5u);
+        BOOST_TEST(bucket.acquire(5) == 5u);
+        BOOST_TEST(bucket.acquire(10) == 5u);
+        auto elapsed = Clock::now() - start;
+        BOOST_TEST((elapsed >= 50ms && elapsed < 500ms));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // token_bucket
+
+    BOOST_AUTO_TEST_SUITE(rate_limited_sender)
+
+    /**
+     * @test 	rate_limited_sender/pace
+     * @brief 	Asserts that items pass through at the configured rate,
+     * 			after the initial burst.
+     */
+    BOOST_AUTO_TEST_CASE(pace) {
+        mpsc::Receiver<int> rx;
+        piper::RateLimitedSender<int> tx(mpsc::Sender<int>(rx), 500, 10);
+
+        auto start = Clock::now();
+        for (int i = 0; i < 60; i++) {
+            tx << i;
+        }
+        auto elapsed = Clock::now() - start;
+        BOOST_TEST((elapsed >= 90ms && elapsed < 1s));
+
+        for (int i = 0; i < 60; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+    }
+
+    /**
+     * @test 	rate_limited_sender/shared
+     * @brief 	Asserts that senders sharing a bucket are limited
+     * 			together, while taking tokens in batches.
+     */
+    BOOST_AUTO_TEST_CASE(shared) {
+        mpsc::Receiver<int> rx;
+        auto bucket = std::make_shared<piper::TokenBucket>(1000, 8);
+
+        auto start = Clock::now();
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back([&] {
+                piper::RateLimitedSender<int> tx(mpsc::Sender<int>(rx),
+                                                 bucket, 4);
+                for (int j = 0; j < 27; j++) {
+                    tx << j;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto elapsed = Clock::now() - start;
+        BOOST_TEST((elapsed >= 90ms && elapsed < 1s));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // rate_limited_sender
+} // namespace piper::tests::rate
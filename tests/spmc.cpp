@@ -34,7 +34,11 @@
 #define BOOST_TEST_MODULE spmc
 #include <boost/test/unit_test.hpp>
 
+#include "piper/factory.hpp"
+#include "piper/internal/sharded.hpp"
+#include "piper/mpsc.hpp"
 #include "piper/spmc.hpp"
+#include "piper/stage.hpp"
 #include "tests.hpp"
 
 /**
@@ -91,6 +95,7 @@ namespace piper::tests::spmc {
         for (int i = 0; i < 5; i++) {
             *tx << i;
         }
+        worker.join();
     }
 
     /**
@@ -99,7 +104,7 @@ namespace piper::tests::spmc {
      * 		  ten integers.
      */
     BOOST_FIXTURE_TEST_CASE(five_receivers, fixture) {
-        std::vector<std::thread> workers(5);
+        std::vector<std::thread> workers;
         std::generate_n(std::back_inserter(workers), 5, [this]() {
             return std::thread(
                 [](auto rx) {
@@ -116,6 +121,9 @@ namespace piper::tests::spmc {
         for (int i = 0; i < 10; i++) {
             *tx << i;
         }
+
+        std::for_each(workers.begin(), workers.end(),
+                      [](auto& rx) { rx.join(); });
     }
 
     BOOST_AUTO_TEST_SUITE_END() // spmc_async
@@ -129,4 +137,227 @@ namespace piper::tests::spmc {
     };
 
     BOOST_AUTO_TEST_SUITE_END() // synch
+
+    BOOST_AUTO_TEST_SUITE(spmc_factory)
+
+    /**
+     * @test spmc_factory/make_channel
+     * @brief Asserts that a sender and receiver returned by
+     * 		  make_channel are connected over a rendezvous buffer.
+     */
+    BOOST_AUTO_TEST_CASE(make_channel) {
+        auto [tx, rx] =
+            piper::make_channel<int, piper::spmc::Topology,
+                                flavor::Rendezvous>();
+        std::thread worker(
+            [](auto&& rx) {
+                for (int i = 0; i < 5; i++) {
+                    BOOST_TEST(rx.recv() == i);
+                }
+            },
+            std::move(rx));
+        for (int i = 0; i < 5; i++) {
+            tx << i;
+        }
+        worker.join();
+    }
+
+    /**
+     * @test spmc_factory/channel
+     * @brief Asserts that a Channel can send to itself.
+     */
+    BOOST_AUTO_TEST_CASE(channel) {
+        piper::spmc::Channel<int> ch;
+        ch << 1;
+        BOOST_TEST(ch.recv() == 1);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // spmc_factory
+
+    BOOST_AUTO_TEST_SUITE(spmc_stealing)
+
+    /**
+     * @test spmc_stealing/consumers
+     * @brief Asserts that items dealt across receiver lanes are each
+     * 		  received exactly once.
+     */
+    BOOST_AUTO_TEST_CASE(consumers) {
+        constexpr int receivers = 6, count = 60000;
+        auto [tx, rx] = piper::make_channel<int, piper::spmc::Topology,
+                                            flavor::Stealing>(64);
+
+        std::vector<std::atomic<int>> received(count);
+        std::atomic<int> total = 0;
+        std::vector<std::thread> workers;
+        for (int r = 0; r < receivers; r++) {
+            workers.emplace_back([&, rx = rx]() mutable {
+                while (total < count) {
+                    if (auto item = rx.try_recv()) {
+                        received[*item]++;
+                        total++;
+                    }
+                }
+            });
+        }
+
+        for (int i = 0; i < count; i++) {
+            tx << i;
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        BOOST_TEST(std::all_of(received.begin(), received.end(),
+                               [](auto& n) { return n == 1; }));
+    }
+
+    /**
+     * @test spmc_stealing/idle
+     * @brief Asserts that items dealt to an idle or destructed
+     * 		  receiver are stolen by the others.
+     */
+    BOOST_AUTO_TEST_CASE(idle) {
+        Sender tx(std::make_shared<piper::internal::StealingBuffer<int>>(4));
+        Receiver busy(tx);
+        auto idle = std::make_unique<Receiver>(tx);
+        auto gone = std::make_unique<Receiver>(tx);
+
+        std::thread worker([&tx] {
+            for (int i = 0; i < 100; i++) {
+                tx << i;
+            }
+        });
+        std::vector<int> items;
+        for (int i = 0; i < 100; i++) {
+            items.push_back(busy.recv());
+            if (i == 10)
+                gone.reset();
+        }
+        worker.join();
+
+        std::sort(items.begin(), items.end());
+        for (int i = 0; i < 100; i++) {
+            BOOST_TEST(items[i] == i);
+        }
+        BOOST_TEST(!idle->try_recv());
+    }
+
+    /**
+     * @test spmc_stealing/sleepers
+     * @brief Asserts that a thread that does not sleep does not hide
+     * 		  another, sleeping thread from notify().
+     */
+    BOOST_AUTO_TEST_CASE(sleepers) {
+        using namespace std::chrono_literals;
+        auto signal = std::make_shared<piper::internal::Signal>();
+        auto woken = std::make_shared<std::atomic<bool>>(false);
+
+        std::thread sleeper([signal, woken] {
+            signal->sleep([] { return false; });
+            *woken = true;
+        });
+        std::this_thread::sleep_for(20ms);
+
+        // A receiver that finds an item instead of sleeping, then exits
+        signal->sleep([] { return true; });
+        signal->notify();
+
+        auto deadline = std::chrono::steady_clock::now() + 2s;
+        while (!*woken && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(1ms);
+        }
+        BOOST_TEST(woken->load());
+        if (*woken)
+            sleeper.join();
+        else
+            sleeper.detach();
+    }
+
+    /**
+     * @test spmc_stealing/wakeup
+     * @brief Asserts that a sleeping receiver is still woken after
+     * 		  another receiver stops receiving.
+     */
+    BOOST_AUTO_TEST_CASE(wakeup) {
+        using namespace std::chrono_literals;
+        auto [tx, rx] = piper::make_channel<int, piper::spmc::Topology,
+                                            flavor::Stealing>(4);
+
+        std::atomic<int> total = 0, exited = 0;
+        std::vector<std::thread> workers;
+        for (int r = 0; r < 2; r++) {
+            workers.emplace_back([&, rx = rx]() mutable {
+                while (rx.recv() >= 0) {
+                    total++;
+                }
+                exited++;
+            });
+        }
+
+        auto await = [](auto&& done) {
+            auto deadline = std::chrono::steady_clock::now() + 2s;
+            while (!done() && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(1ms);
+            }
+            return done();
+        };
+
+        for (int i = 0; i < 1000; i++) {
+            tx << i;
+            if (i % 10 == 0)
+                std::this_thread::yield();
+        }
+        BOOST_TEST(await([&] { return total == 1000; }));
+
+        // One receiver exits while the other sleeps
+        tx << -1;
+        BOOST_TEST(await([&] { return exited == 1; }));
+        std::this_thread::sleep_for(10ms);
+        for (int i = 0; i < 10; i++) {
+            tx << i;
+        }
+        BOOST_TEST(await([&] { return total == 1010; }));
+
+        tx << -1;
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @test spmc_stealing/stages
+     * @brief Asserts that stages over stealing receivers wake for
+     * 		  items sent while they wait, and end once the sender
+     * 		  is gone.
+     */
+    BOOST_AUTO_TEST_CASE(stages) {
+        using namespace std::chrono_literals;
+        auto tx = std::make_unique<Sender>(
+            std::make_shared<piper::internal::StealingBuffer<int>>(4));
+        piper::mpsc::Receiver<int> sink;
+
+        std::vector<piper::Stage> stages;
+        for (int s = 0; s < 2; s++) {
+            stages.emplace_back(Receiver(*tx), piper::mpsc::Sender<int>(sink),
+                                [](int x) { return x; });
+        }
+        for (int i = 0; i < 20; i++) {
+            std::this_thread::sleep_for(2ms);
+            *tx << i;
+        }
+        std::vector<int> items;
+        for (int i = 0; i < 20; i++) {
+            items.push_back(sink.recv());
+        }
+        std::sort(items.begin(), items.end());
+        for (int i = 0; i < 20; i++) {
+            BOOST_TEST(items[i] == i);
+        }
+
+        tx.reset();
+        for (auto& stage : stages) {
+            stage.join();
+        }
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // spmc_stealing
 } // namespace piper::tests::spmc
@@ -0,0 +1,232 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		stage.cpp
+ * @brief		Stage runner testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE stage
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "piper/mpsc.hpp"
+#include "piper/spmc.hpp"
+#include "piper/stage.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::stage
+ * @brief		Testing suite for the pipeline stage runner
+ */
+namespace piper::tests::stage {
+    BOOST_AUTO_TEST_SUITE(stage_runner)
+
+    /**
+     * @test 	stage_runner/forward
+     * @brief 	Asserts that a stage maps and filters items in order,
+     * 			and finishes once its upstream closes.
+     */
+    BOOST_AUTO_TEST_CASE(forward) {
+        auto source = std::make_unique<spmc::Sender<int>>();
+        mpsc::Receiver<int> sink;
+
+        piper::Stage stage(spmc::Receiver<int>(*source),
+                           mpsc::Sender<int>(sink),
+                           [](int x) -> std::optional<int> {
+                               if (x % 2)
+                                   return std::nullopt;
+                               return x * 10;
+                           });
+
+        for (int i = 0; i < 100; i++) {
+            *source << i;
+        }
+        for (int i = 0; i < 100; i += 2) {
+            BOOST_TEST(sink.recv() == i * 10);
+        }
+
+        source.reset();
+        stage.join();
+        BOOST_TEST(!stage.joinable());
+        BOOST_TEST(!sink.try_recv());
+    }
+
+    /**
+     * @test 	stage_runner/stop
+     * @brief 	Asserts that an idle stage stops on request, even when
+     * 			its upstream never closes.
+     */
+    BOOST_AUTO_TEST_CASE(stop) {
+        mpsc::Receiver<int> upstream;
+        mpsc::Sender<int> tx(upstream);
+        std::atomic<int> sum = 0;
+
+        piper::Stage stage(std::move(upstream), [&](int x) { sum += x; });
+        tx << 1 << 2 << 3;
+        while (sum != 6) {
+            std::this_thread::yield();
+        }
+
+        stage.stop();
+        stage.join();
+        BOOST_TEST(sum == 6);
+    }
+
+    /**
+     * @test 	stage_runner/options
+     * @brief 	Asserts that a stage's thread is named and pinned
+     * 			before it runs.
+     */
+    BOOST_AUTO_TEST_CASE(options) {
+        auto source = std::make_unique<spmc::Sender<int>>();
+        mpsc::Receiver<std::string> sink;
+
+        piper::Stage stage(
+            spmc::Receiver<int>(*source), mpsc::Sender<std::string>(sink),
+            [](int) {
+                char name[16] = {};
+                pthread_getname_np(pthread_self(), name, sizeof(name));
+                return std::string(name) + "@" +
+                       std::to_string(sched_getcpu());
+            },
+            {.name = "piper-stage-name-too-long", .cpus = {0}});
+
+        *source << 1;
+        BOOST_TEST(sink.recv() == "piper-stage-nam@0");
+        source.reset();
+        stage.join();
+    }
+
+    /**
+     * @test 	stage_runner/errors
+     * @brief 	Asserts that exceptions from the function reach join(),
+     * 			and that options which cannot be applied throw.
+     */
+    BOOST_AUTO_TEST_CASE(errors) {
+        spmc::Sender<int> source;
+        piper::Stage stage(spmc::Receiver<int>(source), [](int) {
+            throw std::logic_error("stage failed");
+        });
+        source << 1;
+        BOOST_CHECK_THROW(stage.join(), std::logic_error);
+
+        BOOST_CHECK_THROW(piper::Stage(spmc::Receiver<int>(source),
+                                       [](int) {}, {.cpus = {-1}}),
+                          std::invalid_argument);
+
+        // Real-time priority needs privileges that may be missing
+        try {
+            piper::Stage fifo(spmc::Receiver<int>(source), [](int) {},
+                              {.priority = 1});
+            int policy;
+            sched_param param;
+            pthread_getschedparam(fifo.native_handle(), &policy, &param);
+            BOOST_TEST(policy == SCHED_FIFO);
+        } catch (const std::system_error& error) {
+            BOOST_TEST(error.code().value() == EPERM);
+        }
+    }
+
+    /// A receiver whose buffer cannot notify listeners
+    struct Deaf {
+            mpsc::Receiver<int> rx;
+
+            int recv() {
+                auto item = rx.recv();
+                if (item < 0)
+                    throw std::runtime_error("closed");
+                return item;
+            }
+            std::optional<int> try_recv() { return rx.try_recv(); }
+            void listen(std::shared_ptr<piper::internal::Listener>) {
+                throw std::logic_error("cannot notify");
+            }
+    };
+
+    /**
+     * @test 	stage_runner/blocking
+     * @brief 	Asserts that a stage blocks in recv() on a receiver
+     * 			whose buffer cannot notify listeners.
+     */
+    BOOST_AUTO_TEST_CASE(blocking) {
+        Deaf deaf;
+        mpsc::Sender<int> tx(deaf.rx);
+        mpsc::Receiver<int> sink;
+
+        piper::Stage stage(std::move(deaf), mpsc::Sender<int>(sink),
+                           [](int x) { return x * 2; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        tx << 1 << 2;
+        BOOST_TEST(sink.recv() == 2);
+        BOOST_TEST(sink.recv() == 4);
+        tx << -1;
+        stage.join();
+    }
+
+    /**
+     * @test 	stage_runner/moved
+     * @brief 	Asserts that a moved-from stage can still be stopped
+     * 			and destructed, and that the moved-to one runs on.
+     */
+    BOOST_AUTO_TEST_CASE(moved) {
+        mpsc::Receiver<int> upstream;
+        mpsc::Sender<int> tx(upstream);
+        std::atomic<int> sum = 0;
+
+        piper::Stage stage(std::move(upstream), [&](int x) { sum += x; });
+        piper::Stage moved(std::move(stage));
+        stage.stop();
+        BOOST_TEST(!stage.joinable());
+
+        tx << 1 << 2;
+        while (sum != 3) {
+            std::this_thread::yield();
+        }
+        stage = std::move(moved);
+        moved.stop();
+        stage.stop();
+        stage.join();
+        BOOST_TEST(sum == 3);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // stage_runner
+} // namespace piper::tests::stage
@@ -0,0 +1,153 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		stream.cpp
+ * @brief		Stream bridge testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+#define BOOST_TEST_MODULE stream
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "piper/stream.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::stream
+ * @brief		Testing suite for stream bridge implementation
+ */
+namespace piper::tests::stream {
+    BOOST_AUTO_TEST_SUITE(stream_bridge)
+
+    /**
+     * @test 	stream_bridge/socketpair
+     * @brief 	Asserts that items of varying size cross a Unix domain
+     * 			socket in order.
+     */
+    BOOST_AUTO_TEST_CASE(socketpair) {
+        int fds[2];
+        BOOST_REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        piper::stream::Receiver<std::string> rx(fds[0], 256);
+
+        std::thread worker([fd = fds[1]] {
+            piper::stream::Sender<std::string> tx(fd, 16);
+            for (int i = 0; i < 10000; i++) {
+                tx << std::string(i % 1000, 'a' + i % 26);
+            }
+        });
+        for (int i = 0; i < 10000; i++) {
+            BOOST_TEST(rx.recv() == std::string(i % 1000, 'a' + i % 26));
+        }
+        worker.join();
+
+        // The sender flushed and closed the stream
+        BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+    }
+
+    /**
+     * @test 	stream_bridge/flush
+     * @brief 	Asserts that queued items are only visible to the
+     * 			receiver once they are flushed.
+     */
+    BOOST_AUTO_TEST_CASE(flush) {
+        int fds[2];
+        BOOST_REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        piper::stream::Receiver<int> rx(fds[0]);
+        piper::stream::Sender<int> tx(fds[1]);
+
+        tx << 1 << 2 << 3;
+        BOOST_TEST(!rx.try_recv());
+        tx.flush();
+        for (int i = 1; i <= 3; i++) {
+            BOOST_TEST(rx.try_recv().value() == i);
+        }
+        BOOST_TEST(!rx.try_recv());
+    }
+
+    /**
+     * @test 	stream_bridge/limit
+     * @brief 	Asserts that a frame larger than the receiver's limit is
+     * 			rejected before its payload is buffered.
+     */
+    BOOST_AUTO_TEST_CASE(limit) {
+        int fds[2];
+        BOOST_REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        piper::stream::Receiver<std::string> rx(fds[0], 256, 1024);
+        piper::stream::Sender<std::string> tx(fds[1]);
+
+        tx << std::string(1024, 'a');
+        tx.flush();
+        BOOST_TEST(rx.recv().size() == 1024);
+
+        // A corrupt length prefix claiming nearly 4 GiB
+        std::uint32_t length = 0xfffffff0;
+        BOOST_REQUIRE(::write(fds[1], &length, sizeof(length)) ==
+                      sizeof(length));
+        BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+    }
+
+    /**
+     * @test 	stream_bridge/pipe
+     * @brief 	Asserts that items cross a pipe from a child process.
+     */
+    BOOST_AUTO_TEST_CASE(pipe) {
+        int fds[2];
+        BOOST_REQUIRE(::pipe(fds) == 0);
+
+        auto child = fork();
+        BOOST_REQUIRE(child >= 0);
+        if (child == 0) {
+            close(fds[0]);
+            {
+                piper::stream::Sender<std::uint64_t> tx(fds[1]);
+                for (std::uint64_t i = 0; i < 100000; i++) {
+                    tx << i;
+                }
+            }
+            _exit(0);
+        }
+
+        close(fds[1]);
+        piper::stream::Receiver<std::uint64_t> rx(fds[0]);
+        for (std::uint64_t i = 0; i < 100000; i++) {
+            BOOST_TEST(rx.recv() == i);
+        }
+        BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+
+        int status;
+        waitpid(child, &status, 0);
+        BOOST_TEST(WIFEXITED(status));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // stream_bridge
+} // namespace piper::tests::stream
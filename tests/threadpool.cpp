@@ -0,0 +1,210 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		threadpool.cpp
+ * @brief		ThreadPool testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE threadpool
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "piper/internal/deque.hpp"
+#include "piper/mpsc.hpp"
+#include "piper/threadpool.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::threadpool
+ * @brief		Testing suite for ThreadPool implementation
+ */
+namespace piper::tests::threadpool {
+    BOOST_AUTO_TEST_SUITE(threadpool_deque)
+
+    /**
+     * @test 	threadpool_deque/steal
+     * @brief 	Asserts that every item pushed onto a work-stealing
+     * 			deque is taken exactly once by its owner or a thief.
+     */
+    BOOST_AUTO_TEST_CASE(steal) {
+        constexpr int count = 100000;
+        piper::internal::WorkDeque<int> deque(4);
+        std::vector<std::atomic<int>> taken(count);
+        std::atomic<bool> done = false;
+
+        std::vector<std::thread> thieves;
+        for (int i = 0; i < 3; i++) {
+            thieves.emplace_back([&] {
+                while (!done) {
+                    if (auto item = deque.steal())
+                        taken[*item]++;
+                }
+            });
+        }
+
+        for (int i = 0; i < count; i++) {
+            deque.push(i);
+            if (i % 3 == 0) {
+                if (auto item = deque.pop())
+                    taken[*item]++;
+            }
+        }
+        while (auto item = deque.pop()) {
+            taken[*item]++;
+        }
+        done = true;
+        for (auto& thief : thieves) {
+            thief.join();
+        }
+
+        BOOST_TEST(std::all_of(taken.begin(), taken.end(),
+                               [](auto& n) { return n == 1; }));
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // threadpool_deque
+
+    BOOST_AUTO_TEST_SUITE(threadpool_submit)
+
+    /**
+     * @test 	threadpool_submit/results
+     * @brief 	Asserts that submitted tasks return their results and
+     * 			exceptions through futures.
+     */
+    BOOST_AUTO_TEST_CASE(results) {
+        piper::ThreadPool pool(4);
+        BOOST_TEST(pool.size() == 4);
+
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 1000; i++) {
+            results.push_back(pool.submit([](int x) { return x * x; }, i));
+        }
+        for (int i = 0; i < 1000; i++) {
+            BOOST_TEST(results[i].get() == i * i);
+        }
+
+        auto failed = pool.submit([] { throw std::runtime_error("task"); });
+        BOOST_CHECK_THROW(failed.get(), std::runtime_error);
+    }
+
+    /**
+     * @test 	threadpool_submit/outside
+     * @brief 	Asserts that tasks submitted by many outside threads
+     * 			all run, even those queued behind a blocked worker.
+     */
+    BOOST_AUTO_TEST_CASE(outside) {
+        piper::ThreadPool pool(2);
+        std::atomic<bool> release = false;
+        auto blocker = pool.submit([&] {
+            while (!release) {
+                std::this_thread::yield();
+            }
+        });
+
+        std::atomic<int> ran = 0;
+        std::vector<std::thread> submitters;
+        for (int i = 0; i < 4; i++) {
+            submitters.emplace_back([&] {
+                for (int j = 0; j < 1000; j++) {
+                    pool.submit([&] { ran++; });
+                }
+            });
+        }
+        for (auto& submitter : submitters) {
+            submitter.join();
+        }
+
+        // The free worker steals from the blocked worker's inbox
+        while (ran != 4000) {
+            std::this_thread::yield();
+        }
+        release = true;
+        blocker.get();
+    }
+
+    /**
+     * @test 	threadpool_submit/nested
+     * @brief 	Asserts that tasks submitted from workers all run
+     * 			before the pool is destroyed.
+     */
+    BOOST_AUTO_TEST_CASE(nested) {
+        std::atomic<int> leaves = 0;
+        std::function<void(int)> split;
+        {
+            piper::ThreadPool pool(4);
+            split = [&](int depth) {
+                if (depth == 0) {
+                    leaves++;
+                    return;
+                }
+                pool.submit(split, depth - 1);
+                pool.submit(split, depth - 1);
+            };
+            pool.submit(split, 14);
+        }
+        BOOST_TEST(leaves == 1 << 14);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // threadpool_submit
+
+    BOOST_AUTO_TEST_SUITE(threadpool_batch)
+
+    /**
+     * @test 	threadpool_batch/receiver
+     * @brief 	Asserts that batches received from a channel are
+     * 			run to completion.
+     */
+    BOOST_AUTO_TEST_CASE(receiver) {
+        piper::mpsc::Receiver<piper::ThreadPool::Batch> rx;
+        piper::mpsc::Sender<piper::ThreadPool::Batch> tx(rx);
+        std::atomic<int> sum = 0;
+
+        for (int i = 0; i < 10; i++) {
+            piper::ThreadPool::Batch batch;
+            for (int j = 0; j < 100; j++) {
+                batch.push_back([&sum, j] { sum += j; });
+            }
+            batch.push_back([] { throw std::runtime_error("discarded"); });
+            tx << std::move(batch);
+        }
+        {
+            piper::ThreadPool pool(4);
+            pool << rx;
+            BOOST_TEST(pool.drain(rx) == 9);
+            BOOST_TEST(!rx.try_recv());
+        }
+        BOOST_TEST(sum == 10 * 4950);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // threadpool_batch
+} // namespace piper::tests::threadpool
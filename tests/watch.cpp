@@ -0,0 +1,135 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		watch.cpp
+ * @brief		Watch channel testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE watch
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "piper/watch.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::watch
+ * @brief		Testing suite for watch channel implementation
+ */
+namespace piper::tests::watch {
+    /**
+     * @brief 	A value whose fields must always be read together
+     */
+    struct Quote {
+            std::uint64_t bid, ask, sequence;
+    };
+
+    BOOST_AUTO_TEST_SUITE(watch_channel)
+
+    /**
+     * @test 	watch_channel/latest
+     * @brief 	Asserts that receivers see only the latest value and
+     * 			track versions independently.
+     */
+    BOOST_AUTO_TEST_CASE(latest) {
+        auto [tx, rx] = piper::watch::channel<int>(1);
+        BOOST_TEST(rx.get() == 1);
+        BOOST_TEST(!rx.changed());
+        BOOST_TEST(!rx.try_recv());
+
+        tx << 2 << 3;
+        auto copy = rx;
+        BOOST_TEST(rx.changed());
+        BOOST_TEST(rx.recv() == 3);
+        BOOST_TEST(!rx.try_recv());
+        BOOST_TEST(copy.try_recv().value() == 3);
+
+        auto late = tx.subscribe();
+        BOOST_TEST(!late.changed());
+        BOOST_TEST(late.get() == 3);
+    }
+
+    /**
+     * @test 	watch_channel/blocking
+     * @brief 	Asserts that recv blocks until a new value is sent,
+     * 			and throws once the sender is dropped.
+     */
+    BOOST_AUTO_TEST_CASE(blocking) {
+        auto [tx, rx] = piper::watch::channel<int>();
+        std::thread worker([tx = std::move(tx)]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            tx << 42;
+        });
+        BOOST_TEST(rx.recv() == 42);
+        worker.join();
+        BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+    }
+
+    /**
+     * @test 	watch_channel/consistent
+     * @brief 	Asserts that readers never observe a torn value while
+     * 			writers update it concurrently.
+     */
+    BOOST_AUTO_TEST_CASE(consistent) {
+        auto [tx, rx] = piper::watch::channel<Quote>({0, 0, 0});
+        std::atomic<bool> done = false;
+        std::atomic<int> torn = 0;
+
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 3; i++) {
+            readers.emplace_back([&done, &torn, rx = rx]() mutable {
+                std::uint64_t last = 0;
+                while (!done) {
+                    auto quote = rx.get();
+                    if (quote.ask != quote.bid + 1 ||
+                        quote.sequence != quote.bid * 2 ||
+                        quote.sequence < last) {
+                        torn++;
+                    }
+                    last = quote.sequence;
+                }
+            });
+        }
+
+        for (std::uint64_t i = 1; i <= 100000; i++) {
+            tx.send(Quote{i, i + 1, i * 2});
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        BOOST_TEST(torn == 0);
+        BOOST_TEST(rx.recv().bid == 100000);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // watch_channel
+} // namespace piper::tests::watch
@@ -0,0 +1,240 @@
+/**
+ * MIT License
+
+ * Copyright (c) 2022 Brian Reece
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file		window.cpp
+ * @brief		Window aggregation testing suite
+ * @author		Brian Reece
+ * @version		0.1
+ * @copyright	MIT License
+ * @date		2026-10-16
+ */
+
+
+#define BOOST_TEST_MODULE window
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "piper/mpsc.hpp"
+#include "piper/spmc.hpp"
+#include "piper/stage.hpp"
+#include "piper/window.hpp"
+#include "tests.hpp"
+
+/**
+ * @namespace 	piper::tests::window
+ * @brief		Testing suite for window aggregation
+ */
+namespace piper::tests::window {
+    using namespace std::chrono_literals;
+    using std::chrono::milliseconds;
+    using std::chrono::nanoseconds;
+
+    /// An item stamped with its event time
+    struct Event {
+            milliseconds at;
+            int value;
+    };
+
+    /// Sums the values of events
+    inline auto sum() {
+        return piper::reducer(0, std::plus<>(),
+                              [](const Event& e) { return e.value; });
+    }
+
+    /// Stamps events with their own time
+    inline auto stamped(milliseconds lateness = {}) {
+        return piper::event_time([](const Event& e) { return e.at; },
+                                 lateness);
+    }
+
+    /// Asserts the bounds, value and size of a window
+    template <typename V>
+    void check(const piper::Window<V>& window, milliseconds start,
+               milliseconds end, V value, std::size_t count) {
+        BOOST_TEST(window.start.count() == nanoseconds(start).count());
+        BOOST_TEST(window.end.count() == nanoseconds(end).count());
+        BOOST_TEST(window.value == value);
+        BOOST_TEST(window.count == count);
+    }
+
+    BOOST_AUTO_TEST_SUITE(windower)
+
+    /**
+     * @test 	windower/tumbling
+     * @brief 	Asserts that tumbling windows close as later events
+     * 			arrive, and that open windows are flushed on expiry.
+     */
+    BOOST_AUTO_TEST_CASE(tumbling) {
+        auto tx = std::make_unique<spmc::Sender<Event>>();
+        piper::Windower rx(spmc::Receiver<Event>(*tx), piper::tumbling(1s),
+                           sum(), stamped());
+
+        *tx << Event{0ms, 1} << Event{100ms, 2} << Event{999ms, 3};
+        BOOST_TEST(!rx.try_recv());
+
+        *tx << Event{1000ms, 4} << Event{1500ms, 5} << Event{2500ms, 6};
+        check(rx.recv(), 0ms, 1000ms, 6, 3);
+        check(rx.recv(), 1000ms, 2000ms, 9, 2);
+        BOOST_TEST(!rx.try_recv());
+
+        tx.reset();
+        check(rx.recv(), 2000ms, 3000ms, 6, 1);
+        BOOST_CHECK_THROW(rx.recv(), std::runtime_error);
+    }
+
+    /**
+     * @test 	windower/sliding
+     * @brief 	Asserts that sliding windows overlap, skip empty
+     * 			windows and combine their panes in order.
+     */
+    BOOST_AUTO_TEST_CASE(sliding) {
+        mpsc::Receiver<Event> source;
+        mpsc::Sender<Event> tx(source);
+        piper::Windower rx(std::move(source), piper::sliding(1s, 500ms),
+                           sum(), stamped());
+
+        tx << Event{0ms, 1} << Event{600ms, 2} << Event{1200ms, 4};
+        tx << Event{5000ms, 8};
+        check(rx.recv(), -500ms, 500ms, 1, 1);
+        check(rx.recv(), 0ms, 1000ms, 3, 2);
+        check(rx.recv(), 500ms, 1500ms, 6, 2);
+        check(rx.recv(), 1000ms, 2000ms, 4, 1);
+        BOOST_TEST(!rx.try_recv());
+
+        mpsc::Receiver<Event> letters;
+        mpsc::Sender<Event> ty(letters);
+        piper::Windower concat(
+            std::move(letters), piper::sliding(3s, 1s),
+            piper::reducer(std::string(), std::plus<>(),
+                           [](const Event& e) {
+                               return std::string(1, char('a' + e.value));
+                           }),
+            stamped());
+        for (int i = 0; i < 6; i++) {
+            ty << Event{milliseconds(i * 1000), i};
+        }
+        check(concat.recv(), -2000ms, 1000ms, std::string("a"), 1);
+        check(concat.recv(), -1000ms, 2000ms, std::string("ab"), 2);
+        check(concat.recv(), 0ms, 3000ms, std::string("abc"), 3);
+        check(concat.recv(), 1000ms, 4000ms, std::string("bcd"), 3);
+        check(concat.recv(), 2000ms, 5000ms, std::string("cde"), 3);
+    }
+
+    /**
+     * @test 	windower/lateness
+     * @brief 	Asserts that events within the allowed lateness are
+     * 			counted, and that later ones are dropped.
+     */
+    BOOST_AUTO_TEST_CASE(lateness) {
+        mpsc::Receiver<Event> source;
+        mpsc::Sender<Event> tx(source);
+        piper::Windower rx(std::move(source), piper::tumbling(1s), sum(),
+                           stamped(1s));
+
+        tx << Event{1500ms, 1} << Event{900ms, 2} << Event{3000ms, 4};
+        check(rx.recv(), 0ms, 1000ms, 2, 1);
+        check(rx.recv(), 1000ms, 2000ms, 1, 1);
+
+        tx << Event{100ms, 8} << Event{5000ms, 16};
+        check(rx.recv(), 3000ms, 4000ms, 4, 1);
+        BOOST_TEST(!rx.try_recv());
+    }
+
+    /**
+     * @test 	windower/session
+     * @brief 	Asserts that sessions grow while events arrive within
+     * 			the gap, and merge when an event bridges them.
+     */
+    BOOST_AUTO_TEST_CASE(session) {
+        mpsc::Receiver<Event> source;
+        mpsc::Sender<Event> tx(source);
+        piper::Windower rx(std::move(source), piper::session(1s), sum(),
+                           stamped(2s));
+
+        tx << Event{0ms, 1} << Event{500ms, 2} << Event{1200ms, 4};
+        tx << Event{3000ms, 8} << Event{2100ms, 16};
+        tx << Event{10000ms, 32};
+        check(rx.recv(), 0ms, 4000ms, 31, 5);
+        BOOST_TEST(!rx.try_recv());
+    }
+
+    /**
+     * @test 	windower/processing
+     * @brief 	Asserts that processing-time windows close by the clock,
+     * 			without later items.
+     */
+    BOOST_AUTO_TEST_CASE(processing) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        piper::Windower rx(std::move(source), piper::tumbling(50ms),
+                           piper::reducer(0, std::plus<>()));
+
+        tx << 1 << 2 << 3;
+        std::size_t count = 0;
+        int total = 0;
+        while (count < 3) {
+            auto window = rx.recv();
+            BOOST_TEST((window.end - window.start == 50ms));
+            count += window.count;
+            total += window.value;
+        }
+        BOOST_TEST(total == 6);
+        BOOST_TEST(!rx.try_recv());
+    }
+
+    /**
+     * @test 	windower/stage
+     * @brief 	Asserts that a stage waits on a windower through its
+     * 			listener, waking as windows close by the clock, and
+     * 			stops on request while its source stays open.
+     */
+    BOOST_AUTO_TEST_CASE(stage) {
+        mpsc::Receiver<int> source;
+        mpsc::Sender<int> tx(source);
+        std::atomic<int> total = 0;
+
+        piper::Stage stage(
+            piper::Windower(std::move(source), piper::tumbling(20ms),
+                            piper::reducer(0, std::plus<>())),
+            [&](piper::Window<int> window) { total += window.value; });
+        tx << 1 << 2 << 3;
+        while (total != 6) {
+            std::this_thread::sleep_for(1ms);
+        }
+
+        stage.stop();
+        stage.join();
+        BOOST_TEST(total == 6);
+    }
+
+    BOOST_AUTO_TEST_SUITE_END() // windower
+} // namespace piper::tests::window